@@ -51,6 +51,20 @@ function stringToAsciiz(s: any): c_ptr {
     }
 }
 
+/// ASCIIZ copies of strings that are passed to native code over and over,
+/// like ImGui labels, keyed by content. They are encoded once and never freed.
+const _internedAsciiz: any = new Map();
+
+/// Return the ASCIIZ copy of \p s, encoding it on first use. Only for a
+/// bounded set of strings: use tmpAsciiz() for text that changes.
+function internAsciiz(s: string): c_ptr {
+    let res: any = _internedAsciiz.get(s);
+    if (res !== undefined) return res;
+    let buf = stringToAsciiz(s);
+    _internedAsciiz.set(s, buf);
+    return buf;
+}
+
 /// Convert a JS string to ASCIIZ.
 function tmpAsciiz(s: any): c_ptr {
     "use unsafe";
@@ -62,18 +76,81 @@ function tmpAsciiz(s: any): c_ptr {
 }
 
 
-let _allocas: c_ptr[] = [];
+// Temporary native memory comes from the bump arena in tmp_arena.h and is
+// released all at once by flushAllocTmp() at the start of every frame/event.
+const _tmp_arena_alloc = $SHBuiltin.extern_c({include: "tmp_arena.h"}, function tmp_arena_alloc(size: c_size_t): c_ptr {
+    throw 0;
+});
+const _tmp_arena_alloc_zero = $SHBuiltin.extern_c({include: "tmp_arena.h"}, function tmp_arena_alloc_zero(size: c_size_t): c_ptr {
+    throw 0;
+});
+const _tmp_arena_reset = $SHBuiltin.extern_c({include: "tmp_arena.h"}, function tmp_arena_reset(): void {
+});
 
+/// Allocate uninitialized temporary memory, valid until the next
+/// flushAllocTmp(), or throw an exception.
 function allocTmp(size: number): c_ptr {
-    let res = calloc(size);
-    _allocas.push(res);
+    "inline";
+    "use unsafe";
+
+    let res = _tmp_arena_alloc(size);
+    if (res === 0) throw Error("OOM");
+    return res;
+}
+
+/// Like allocTmp(), but the memory is zeroed.
+function allocTmpZero(size: number): c_ptr {
+    "inline";
+    "use unsafe";
+
+    let res = _tmp_arena_alloc_zero(size);
+    if (res === 0) throw Error("OOM");
     return res;
 }
 
 function flushAllocTmp(): void {
-    for (let i = 0; i < _allocas.length; ++i) {
-        _free(_allocas[i]);
-    }
-    let empty: c_ptr[] = [];
-    _allocas = empty;
-}
\ No newline at end of file
+    _tmp_arena_reset();
+}
+
+// Typed-array views over native memory, see native_view.h. The memory should
+// come from nativeAlloc(); views must not be used after nativeFree().
+const _native_view_alloc = $SHBuiltin.extern_c({}, function native_view_alloc(size: c_size_t): c_ptr {
+    throw 0;
+});
+const _native_view_free = $SHBuiltin.extern_c({}, function native_view_free(p: c_ptr): void {
+});
+const _nativeArrayBuffer: any = globalThis.__nativeArrayBuffer;
+
+/// Allocate zeroed native memory that can be mapped, or throw an exception.
+function nativeAlloc(size: number): c_ptr {
+    "inline";
+    "use unsafe";
+
+    let res = _native_view_alloc(size);
+    if (res === 0) throw Error("OOM");
+    return res;
+}
+
+/// Free memory allocated with nativeAlloc().
+function nativeFree(ptr: c_ptr): void {
+    _native_view_free(ptr);
+}
+
+/// An ArrayBuffer over the \p byteLength bytes at \p ptr, which must be aligned
+/// to \p alignment for the views that will be created over it.
+function nativeArrayBuffer(ptr: c_ptr, byteLength: number, alignment: number): any {
+    return _nativeArrayBuffer(_sh_ptr_to_double(ptr), byteLength, alignment);
+}
+
+function nativeFloat32Array(ptr: c_ptr, length: number): Float32Array {
+    return new Float32Array(nativeArrayBuffer(ptr, length * 4, 4));
+}
+function nativeFloat64Array(ptr: c_ptr, length: number): Float64Array {
+    return new Float64Array(nativeArrayBuffer(ptr, length * 8, 8));
+}
+function nativeInt32Array(ptr: c_ptr, length: number): Int32Array {
+    return new Int32Array(nativeArrayBuffer(ptr, length * 4, 4));
+}
+function nativeUint8Array(ptr: c_ptr, length: number): Uint8Array {
+    return new Uint8Array(nativeArrayBuffer(ptr, length, 1));
+}
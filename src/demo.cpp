@@ -16,6 +16,15 @@
 #include "soloud_wav.h"
 #include "soloud_wavstream.h"
 
+#include "frame_profiler.h"
+#include "game.h"
+#include "input_latency.h"
+#include "input_log.h"
+#include "job_system.h"
+#include "rng.h"
+#include "game_render.h"
+#include "sim_thread.h"
+
 #include <deque>
 #include <map>
 #include <memory>
@@ -52,17 +61,6 @@ class Sound {
 };
 //
 
-static const float PHYS_FPS = 60;
-static const float PHYS_DT = 1.0f / PHYS_FPS;
-static const float ASSUMED_W = 800;
-static const float INV_ASSUMED_W = 1.0f / ASSUMED_W;
-static const float ASSUMED_H = 600;
-static const float INV_ASSUMED_H = 1.0f / ASSUMED_H;
-
-static double mathRandom(double range) {
-  return rand() * (1.0 / (RAND_MAX + 1.0)) * range;
-}
-
 static sg_sampler s_sampler = {};
 
 struct InternalImage {
@@ -82,6 +80,33 @@ IMPORT_IMAGE(background);
 
 std::array<InternalImage *, 3> s_internalImages = {&s_img_ship, &s_img_enemy, &s_img_background};
 
+/// Decode an internal image or an image file to RGBA8. The result must be
+/// freed with stbi_image_free().
+static unsigned char *decode_image(const char *path, int *w, int *h) {
+  const unsigned char *buf = nullptr;
+  unsigned size = 0;
+
+  for (auto img : s_internalImages) {
+    if (strcmp(img->name, path) == 0) {
+      buf = img->data;
+      size = img->size;
+      break;
+    }
+  }
+
+  unsigned char *data;
+  int n;
+  if (buf) {
+    data = stbi_load_from_memory(buf, size, w, h, &n, 4);
+  } else {
+    data = stbi_load(path, w, h, &n, 4);
+  }
+
+  if (!data)
+    abort();
+  return data;
+}
+
 class Image {
  public:
   int w_ = 0, h_ = 0;
@@ -89,27 +114,7 @@ class Image {
   simgui_image_t simguiImage_ = {};
 
   explicit Image(const char *path) {
-    const unsigned char *buf = nullptr;
-    unsigned size = 0;
-
-    for (auto img : s_internalImages) {
-      if (strcmp(img->name, path) == 0) {
-        buf = img->data;
-        size = img->size;
-        break;
-      }
-    }
-
-    unsigned char *data;
-    int n;
-    if (buf) {
-      data = stbi_load_from_memory(buf, size, &w_, &h_, &n, 4);
-    } else {
-      data = stbi_load(path, &w_, &h_, &n, 4);
-    }
-
-    if (!data)
-      abort();
+    unsigned char *data = decode_image(path, &w_, &h_);
 
     image_ = sg_make_image(sg_image_desc{
         .width = w_,
@@ -133,18 +138,11 @@ static std::unique_ptr<Image> s_enemy_image;
 static std::unique_ptr<Image> s_background_image;
 static std::unique_ptr<Sound> s_sound;
 
-static int s_enemySpawnCounter = 0;
-static const int s_enemySpawnRate = 120;
-
-static float s_oldBackgroundX = 0;
-static float s_backgroundX = 0;
-static float s_backgroundSpeed = 2;
-
-static bool s_keys[512];
-
-static ImVec2 s_winOrg;
-static ImVec2 s_winSize;
-static ImVec2 s_scale;
+static SpriteBatch s_batch;
+/// Set by INSTANCED_QUADS: draw the game with QuadRenderer instead of
+/// SpriteBatch.
+static bool s_useQuads = false;
+static QuadRenderer s_quads;
 
 static void load_images() {
   s_ship_image = std::make_unique<Image>("ship");
@@ -152,209 +150,151 @@ static void load_images() {
   s_background_image = std::make_unique<Image>("background");
 }
 
+/// Set up QuadRenderer with an atlas of the game images, in GameSprite order.
+/// Returns false if it isn't supported by the current backend.
+static bool setup_quads() {
+  if (!s_quads.setup(1 << 17, ASSUMED_W, ASSUMED_H))
+    return false;
+  static const char *const names[SPRITE_COUNT] = {"background", "ship", "enemy"};
+  QuadRenderer::AtlasImage images[SPRITE_COUNT];
+  for (int i = 0; i < SPRITE_COUNT; ++i)
+    images[i].rgba = decode_image(names[i], &images[i].w, &images[i].h);
+  s_quads.setAtlas(images, SPRITE_COUNT);
+  for (auto &image : images)
+    stbi_image_free((void *)image.rgba);
+  return true;
+}
+
 #define IM_COL32(r, g, b, a)                                                                 \
   ((ImU32)(((ImU32)(a)&0xFF) << 24) | (((ImU32)(b)&0xFF) << 16) | (((ImU32)(g)&0xFF) << 8) | \
    (((ImU32)(r)&0xFF) << 0))
 
-static void push_rect_image(float x, float y, float w, float h, simgui_image_t img) {
-  x = x * s_scale.x + s_winOrg.x;
-  y = y * s_scale.y + s_winOrg.y;
-  w *= s_scale.x;
-  h *= s_scale.y;
-
-  ImDrawList_AddImage(
-      igGetWindowDrawList(),
-      simgui_imtextureid(img),
-      ImVec2{x, y},
-      ImVec2{x + w, y + h},
-      ImVec2{0, 0},
-      ImVec2{1, 1},
-      IM_COL32(255, 255, 255, 255));
-}
-
-static void push_rect_with_color(float x, float y, float w, float h, sg_color color) {
-  x = x * s_scale.x + s_winOrg.x;
-  y = y * s_scale.y + s_winOrg.y;
-  w *= s_scale.x;
-  h *= s_scale.y;
-
-  ImDrawList_AddRectFilled(
-      igGetWindowDrawList(),
-      ImVec2{x, y},
-      ImVec2{x + w, y + h},
-      IM_COL32(255 * color.r, 255 * color.g, 255 * color.b, 255 * color.a),
-      0.0f,
-      0);
-}
-
-static void draw_fill_px(float x, float y, float w, float h, sg_color color) {
-  push_rect_with_color(x, y, w, h, color);
-}
-
-static void draw_blit_px(Image *image, float x, float y, float w, float h) {
-  push_rect_image(x, y, w, h, image->simguiImage_);
-}
-
-class Actor {
- public:
-  float oldX, oldY;
-  float x, y, width, height, velX, velY;
-
-  explicit Actor(float x, float y, float width, float height, float velX, float velY)
-      : oldX(x), oldY(y), x(x), y(y), width(width), height(height), velX(velX), velY(velY) {}
-
-  virtual void update(bool save) {
-    if (save) {
-      oldX = x;
-      oldY = y;
-    }
-    x += velX;
-    y += velY;
-  }
-
-  float curX(float dt) const {
-    return x + (x - oldX) * dt;
-  }
-  float curY(float dt) const {
-    return y + (y - oldY) * dt;
-  }
-};
-
-class Ship : public Actor {
- public:
-  float speed = 5 * 2;
-  explicit Ship(float x, float y) : Actor(x, y, s_ship_image->w_, s_ship_image->h_, 0, 0) {}
-
-  virtual void update(bool save) {
-    if (s_keys[SAPP_KEYCODE_LEFT])
-      velX = -speed;
-    else if (s_keys[SAPP_KEYCODE_RIGHT])
-      velX = speed;
-    else
-      velX = 0;
-    if (s_keys[SAPP_KEYCODE_UP])
-      velY = -speed;
-    else if (s_keys[SAPP_KEYCODE_DOWN])
-      velY = speed;
-    else
-      velY = 0;
-    Actor::update(save);
-  }
-
-  void draw(float dt) const {
-    draw_blit_px(s_ship_image.get(), curX(dt), curY(dt), width, height);
-  }
-};
-
-class Enemy : public Actor {
- public:
-  explicit Enemy(float x, float y) : Actor(x, y, 64, 64, -2 * 2, 0) {}
-
-  void draw(float dt) const {
-    draw_blit_px(s_enemy_image.get(), curX(dt), curY(dt), width, height);
-  }
-};
-
-class Bullet : public Actor {
- public:
-  explicit Bullet(float x, float y) : Actor(x, y, 5, 5, 8 * 2, 0) {}
-
-  void draw(float dt) const {
-    draw_fill_px(curX(dt), curY(dt), width, height, {1, 1, 0, 1});
-  }
-};
-
-class Particle : public Actor {
- public:
-  float life, maxLife, alpha;
-
-  explicit Particle(float x, float y)
-      : Actor(x, y, 0, 0, (mathRandom(4) - 2) * 2, ((mathRandom(4) - 2) * 2)),
-        life(0),
-        maxLife((mathRandom(30) + 50) / 2),
-        alpha(1) {
-    width = height = mathRandom(2) + 1;
-  }
-
-  virtual void update(bool save) {
-    Actor::update(save);
-    ++life;
-    alpha = 1 - (life / maxLife);
-  }
-
-  void draw(float dt) const {
-    draw_fill_px(curX(dt) - width / 2, curY(dt) - height / 2, width, height, {1, 0.5, 0, alpha});
-  }
-
-  bool isAlive() const {
-    return life < maxLife;
-  }
-};
-
-class Explosion {
- public:
-  float x, y;
-  std::vector<Particle> particles;
-
-  explicit Explosion(float x, float y) : x(x), y(y) {
-    for (int i = 0; i < 50; ++i) {
-      particles.emplace_back(x, y);
-    }
-  }
-
-  void update(bool save) {
-    for (long i = 0; i < particles.size();) {
-      particles[i].update(save);
-      if (!particles[i].isAlive()) {
-        particles.erase(particles.begin() + i);
-        continue;
-      }
-      ++i;
-    }
-  }
-
-  void draw(float dt) const {
-    for (auto &particle : particles) {
-      particle.draw(dt);
-    }
-  }
-
-  bool isAlive() const {
-    return !particles.empty();
-  }
-};
-
-static std::unique_ptr<Ship> s_ship;
-static std::vector<Bullet> s_bullets;
-static std::vector<Enemy> s_enemies;
-static std::vector<Explosion> s_explosions;
 static bool s_pause = false;
+/// Seed of the game and spreadsheet RNGs, from --seed=N or $GAME_SEED.
+static uint64_t s_seed = 1;
+/// --record=file: write the game input to an input log.
+static const char *s_recordPath = nullptr;
+static InputRecorder s_recorder;
+/// --replay=file: play an input log back at a fixed timestep of one physics
+/// tick per frame, ignoring the keyboard and the wall clock, then quit.
+static const char *s_replayPath = nullptr;
+static InputReplay s_replay;
+/// Separate from the game RNG, so that the spreadsheet doesn't change the game.
+static Rng s_uiRng;
+/// Runs the game, except while replaying, which ticks once per frame on the
+/// render thread instead.
+static SimThread s_sim;
+/// The state drawn while replaying.
+static GameSnapshot s_replayGame;
+/// Runs the per-window work of a frame before the UI is built. $JOB_THREADS
+/// sets the number of threads, by default all hardware threads.
+static std::unique_ptr<JobSystem> s_jobs;
+/// The game, interpolated by a job for gameWindow().
+static GameRenderData s_gameRender;
+
+enum Stage { STAGE_SIM, STAGE_JOBS, STAGE_IMGUI, STAGE_SIMGUI_RENDER, STAGE_SDTX, STAGE_COMMIT };
+static FrameProfiler s_profiler({"sim", "jobs", "imgui", "simgui", "sdtx", "commit"});
+/// Where F2 and $FRAME_TRACE write the Chrome trace.
+static const char *s_tracePath = "frame_trace.json";
+/// Key events, stamped in app_event(), until the first frame that draws the tick
+/// that applied them is committed. Sequence numbers are game ticks.
+static InputLatency s_latency;
+/// Where the latency histogram is written at exit.
+static const char *s_latencyPath = "input_latency.csv";
+
+/// $JOB_THREADS, or 0 (all hardware threads) if it is unset or not a number
+/// in [0, JobSystem::MAX_THREADS].
+static unsigned jobThreadsFromEnv() {
+  const char *value = getenv("JOB_THREADS");
+  if (!value)
+    return 0;
+  char *end;
+  long threads = strtol(value, &end, 0);
+  if (end == value || *end || threads < 0 || threads > (long)JobSystem::MAX_THREADS) {
+    char msg[128];
+    snprintf(
+        msg,
+        sizeof(msg),
+        "JOB_THREADS=%s ignored, expected 0..%u",
+        value,
+        JobSystem::MAX_THREADS);
+    slog_func("WARN", 2, 0, msg, __LINE__, __FILE__, nullptr);
+    return 0;
+  }
+  return (unsigned)threads;
+}
 
 void app_init() {
   stm_setup();
 
   sg_desc desc = {.context = sapp_sgcontext(), .logger.func = slog_func};
   sg_setup(&desc);
-  simgui_setup(simgui_desc_t{});
+  // SIMGUI_APPEND=1 uploads the UI with one sg_append_buffer() per draw list
+  // instead of the GL default of one sg_update_buffer() per buffer.
+  simgui_setup(simgui_desc_t{
+      .upload_mode =
+          getenv("SIMGUI_APPEND") ? SIMGUI_UPLOADMODE_APPEND : _SIMGUI_UPLOADMODE_DEFAULT});
 
   s_sound = std::make_unique<Sound>(getenv("NOSOUND") == nullptr);
+  s_gameOptions.stableOrder = getenv("STABLE_ORDER") != nullptr;
 
   s_sampler = sg_make_sampler(sg_sampler_desc{
       .min_filter = SG_FILTER_LINEAR,
       .mag_filter = SG_FILTER_LINEAR,
   });
   load_images();
+  s_useQuads = getenv("INSTANCED_QUADS") != nullptr && setup_quads();
 
   sdtx_desc_t sdtx_desc = {.fonts = {sdtx_font_kc854()}, .logger.func = slog_func};
   sdtx_setup(&sdtx_desc);
 
-  s_ship = std::make_unique<Ship>(800.0f / 2, 600.0f / 2);
+  // FRAME_TRACE=file records a trace of the whole run, written at exit.
+  if (const char *trace = getenv("FRAME_TRACE")) {
+    s_tracePath = trace;
+    s_profiler.startTrace(s_tracePath);
+  }
+  if (const char *path = getenv("INPUT_LATENCY_CSV"))
+    s_latencyPath = path;
+  s_jobs = std::make_unique<JobSystem>(jobThreadsFromEnv());
+
+  if (s_replayPath) {
+    if (!s_replay.load(s_replayPath))
+      exit(1);
+    s_seed = s_replay.seed();
+  }
+  if (s_recordPath && !s_recorder.open(s_recordPath, s_seed))
+    exit(1);
+
+  game_seed(s_seed);
+  s_uiRng.seed(s_seed);
+  game_init(
+      s_ship_image->w_,
+      s_ship_image->h_,
+      s_background_image->w_,
+      GameHooks{
+          .explosion = [] { s_sound->play(s_sound->explosion); },
+          .input = [](const InputEvent &event) {
+            s_recorder.key(game_tick(), event.keyCode, event.down);
+            // Applied by the tick that is about to run.
+            s_latency.consumed(game_tick() + 1, event.time);
+          }});
 }
 
 void app_cleanup() {
+  s_sim.stop();
+  s_jobs.reset();
+  if (s_profiler.tracing())
+    s_profiler.stopTrace();
+  if (s_latency.count())
+    s_latency.writeCsv(s_latencyPath);
+  if (s_recorder.isOpen())
+    s_recorder.finish(game_tick(), game_checksum());
+
   s_ship_image.reset();
   s_enemy_image.reset();
   s_background_image.reset();
+  if (s_useQuads)
+    s_quads.shutdown();
   s_sound.reset();
   simgui_shutdown();
   sdtx_shutdown();
@@ -367,169 +307,111 @@ void app_event(const sapp_event *ev) {
     sapp_request_quit();
     return;
   }
+  // F2 starts and stops capturing a frame trace.
+  if (ev->type == SAPP_EVENTTYPE_KEY_DOWN && ev->key_code == SAPP_KEYCODE_F2 && !ev->key_repeat) {
+    if (s_profiler.tracing())
+      s_profiler.stopTrace();
+    else
+      s_profiler.startTrace(s_tracePath);
+    return;
+  }
 
-  // For now game keys are handled outside of Imgui.
-  if (ev->type == SAPP_EVENTTYPE_KEY_DOWN) {
-    s_keys[ev->key_code] = true;
-    if (ev->key_code == SAPP_KEYCODE_SPACE) {
-      s_bullets.emplace_back(s_ship->x + s_ship->width, s_ship->y + s_ship->height / 2.0 - 2.5);
+  // For now game keys are handled outside of Imgui. While replaying, the log
+  // is the only source of game input.
+  if (!s_replayPath &&
+      (ev->type == SAPP_EVENTTYPE_KEY_DOWN || ev->type == SAPP_EVENTTYPE_KEY_UP)) {
+    bool down = ev->type == SAPP_EVENTTYPE_KEY_DOWN;
+    if (!game_post_key(ev->key_code, down, stm_now()))
+      slog_func("WARN", 2, 0, "input queue full, key event dropped", __LINE__, __FILE__, nullptr);
+    if (down && ev->key_code == SAPP_KEYCODE_SPACE)
       s_sound->play(s_sound->shot);
-    }
-  } else if (ev->type == SAPP_EVENTTYPE_KEY_UP) {
-    s_keys[ev->key_code] = false;
-    if (ev->key_code == SAPP_KEYCODE_P)
+    if (!down && ev->key_code == SAPP_KEYCODE_P) {
       s_pause = !s_pause;
+      s_sim.setPaused(s_pause);
+    }
   }
 
   if (simgui_handle_event(ev))
     return;
 }
 
-static bool checkCollision(Actor &a, Actor &b) {
-  return a.x < b.x + b.width && a.x + a.width > b.x && a.y < b.y + b.height && a.y + a.height > b.y;
-}
-
-static void createExplosion(float x, float y) {
-  s_explosions.emplace_back(x, y);
-  s_sound->play(s_sound->explosion);
-}
-
-// Update game state
-static void update_game_state(bool save) {
-  if (save)
-    s_oldBackgroundX = s_backgroundX;
-  s_backgroundX -= s_backgroundSpeed;
-  if (s_backgroundX <= -s_background_image->w_) {
-    s_backgroundX += s_background_image->w_;
-    s_oldBackgroundX += s_background_image->w_;
-  }
-
-  s_ship->update(save);
-
-  for (long i = 0; i < s_bullets.size();) {
-    s_bullets[i].update(save);
-    if (s_bullets[i].x > ASSUMED_W) {
-      s_bullets.erase(s_bullets.begin() + i);
-      continue;
-    }
-    ++i;
-  }
-
-  ++s_enemySpawnCounter;
-  if (s_enemySpawnCounter >= s_enemySpawnRate) {
-    float y = mathRandom(ASSUMED_H - 64);
-    s_enemies.emplace_back(ASSUMED_W, y);
-    s_enemySpawnCounter = 0;
-  }
-
-  for (long i = 0; i < s_enemies.size();) {
-    s_enemies[i].update(save);
-
-    if (s_enemies[i].x < -s_enemies[i].width) {
-      s_enemies.erase(s_enemies.begin() + i);
-      continue;
-    }
+static bool s_started = false;
+static uint64_t s_start_time = 0;
 
-    bool destroy = false;
-    if (checkCollision(*s_ship, s_enemies[i])) {
-      createExplosion(
-          s_enemies[i].x + s_enemies[i].width / 2, s_enemies[i].y + s_enemies[i].height / 2);
-      destroy = true;
-    } else {
-      for (long j = 0; j < s_bullets.size();) {
-        if (checkCollision(s_bullets[j], s_enemies[i])) {
-          if (!destroy) {
-            createExplosion(
-                s_enemies[i].x + s_enemies[i].width / 2, s_enemies[i].y + s_enemies[i].height / 2);
-          }
-          s_bullets.erase(s_bullets.begin() + j);
-          destroy = true;
-          continue;
-        }
-        ++j;
-      }
-    }
-    if (destroy) {
-      s_enemies.erase(s_enemies.begin() + i);
-      continue;
-    }
-    ++i;
+/// Advance the replay by one tick, or quit once the log is exhausted.
+static void replayTick() {
+  uint32_t tick = game_tick();
+  if (!s_replay.finished(tick)) {
+    s_replay.apply(tick);
+    ScopedStage stage(s_profiler, STAGE_SIM);
+    update_game_state(true);
+    return;
   }
 
-  for (long i = 0; i < s_explosions.size();) {
-    s_explosions[i].update(save);
-    if (!s_explosions[i].isAlive()) {
-      s_explosions.erase(s_explosions.begin() + i);
-      continue;
-    }
-    ++i;
-  }
+  static bool done = false;
+  if (done)
+    return;
+  done = true;
+  uint64_t checksum = game_checksum();
+  printf(
+      "replay: %u ticks, checksum %016llx, %s\n",
+      tick,
+      (unsigned long long)checksum,
+      checksum == s_replay.checksum() ? "matches the recording" : "MISMATCH");
+  sapp_request_quit();
 }
 
-// Render game frame
-static void render_game_frame(float dt) {
-  float bkgX = s_oldBackgroundX + (s_backgroundX - s_oldBackgroundX) * dt;
-  draw_blit_px(s_background_image.get(), bkgX, 0, s_background_image->w_, ASSUMED_H);
-  draw_blit_px(
-      s_background_image.get(),
-      bkgX + s_background_image->w_,
-      0,
-      s_background_image->w_,
-      ASSUMED_H);
-
-  s_ship->draw(dt);
-
-  for (const auto &bullet : s_bullets) {
-    bullet.draw(dt);
+/// Return the latest state of the game, and in \p renderDT how far \p now is
+/// between its last two ticks.
+static const GameSnapshot &advanceGame(uint64_t now, float *renderDT) {
+  if (s_replayPath) {
+    replayTick();
+    game_snapshot(s_replayGame);
+    *renderDT = 1;
+    return s_replayGame;
+  }
+
+  // The ticks ran on the simulation thread. Charge the ones since the last
+  // frame to the sim stage.
+  static uint64_t lastTickTime = 0;
+  const SimThread::Frame &frame = s_sim.acquire();
+  if (frame.tickTime != lastTickTime) {
+    s_profiler.recordThread(
+        STAGE_SIM, "sim", frame.batchStart, frame.batchEnd, frame.tickTime - lastTickTime);
+    lastTickTime = frame.tickTime;
   }
-
-  for (const auto &enemy : s_enemies) {
-    enemy.draw(dt);
-  }
-
-  for (const auto &explosion : s_explosions) {
-    explosion.draw(dt);
-  }
-}
-
-static bool s_started = false;
-static uint64_t s_start_time = 0;
-static double s_last_game_time = 0;
-static double s_game_time = 0;
-static int s_frame_count = 0;
-static uint64_t s_last_fps_time = 0;
-static uint64_t s_fps = 0;
-
-static void gameWindow(uint64_t now) {
   double render_time = stm_sec(stm_diff(now, s_start_time));
-  bool save = true;
-  while (s_game_time <= render_time) {
-    if (save)
-      s_last_game_time = s_game_time;
-    s_game_time += PHYS_DT;
-    if (!s_pause)
-      update_game_state(save);
-    save = false;
-  }
-
-  // s_last_game_time ... render_time ... s_game_time
-  float renderDT = render_time >= s_last_game_time && s_game_time > s_last_game_time
-      ? (render_time - s_last_game_time) / (s_game_time - s_last_game_time)
+  // frame.lastTime ... render_time ... frame.time
+  *renderDT = render_time >= frame.lastTime && frame.time > frame.lastTime
+      ? (float)((render_time - frame.lastTime) / (frame.time - frame.lastTime))
       : 0;
+  return frame.game;
+}
 
+static void gameWindow() {
   float app_w = sapp_widthf();
   float app_h = sapp_heightf();
   igSetNextWindowPos((ImVec2){app_w * 0.10f, app_h * 0.10f}, ImGuiCond_Once, (ImVec2){0, 0});
   igSetNextWindowSize((ImVec2){app_w * 0.8f, app_h * 0.8f}, ImGuiCond_Once);
   if (igBegin("Game", NULL, 0)) {
     // Get the top-left corner and size of the window
-    igGetCursorScreenPos(&s_winOrg);
-    igGetContentRegionAvail(&s_winSize);
-
-    s_scale.x = s_winSize.x * INV_ASSUMED_W;
-    s_scale.y = s_winSize.y * INV_ASSUMED_H;
-
-    render_game_frame(renderDT);
+    ImVec2 winOrg, winSize;
+    igGetCursorScreenPos(&winOrg);
+    igGetContentRegionAvail(&winSize);
+
+    ImDrawList *dl = igGetWindowDrawList();
+    float bkgW = s_background_image->w_;
+    if (s_useQuads) {
+      render_game_instanced(s_gameRender, s_quads, bkgW);
+      s_quads.upload();
+      s_quads.addToDrawList(dl, winOrg, winSize, sapp_dpi_scale());
+    } else {
+      GameTextures textures = {
+          simgui_imtextureid(s_background_image->simguiImage_),
+          simgui_imtextureid(s_ship_image->simguiImage_),
+          simgui_imtextureid(s_enemy_image->simguiImage_)};
+      render_game_batched(s_gameRender, s_batch, dl, winOrg, winSize, textures, bkgW);
+    }
   }
   igEnd();
 }
@@ -547,11 +429,37 @@ static void chooseColorWindow() {
   igEnd();
 }
 
-static void bouncingBallWindow() {
-  // Global variables for ball position and velocity
-  static float ball_x = 0.0f, ball_y = 0.0f;
-  static float velocity_x = 2, velocity_y = 1.5;
+// Ball position and velocity, and the size of the window content it bounces in,
+// as of the last frame.
+static float s_ballX = 0.0f, s_ballY = 0.0f;
+static float s_ballVelX = 2, s_ballVelY = 1.5;
+static ImVec2 s_ballArea = {0, 0};
+static const float BALL_RADIUS = 10.0f;
+
+/// Move the ball by one frame. Runs as a job, so it doesn't touch ImGui.
+static void moveBall() {
+  // The window hasn't been laid out yet.
+  if (s_ballArea.x <= 0 || s_ballArea.y <= 0)
+    return;
+
+  // Update ball position
+  s_ballX += s_ballVelX;
+  s_ballY += s_ballVelY;
 
+  // Bounce logic for X
+  if (s_ballX - BALL_RADIUS <= 0 || s_ballX + BALL_RADIUS >= s_ballArea.x) {
+    s_ballVelX *= -1;
+    s_ballX = (s_ballX - BALL_RADIUS <= 0) ? BALL_RADIUS : s_ballArea.x - BALL_RADIUS;
+  }
+
+  // Bounce logic for Y
+  if (s_ballY - BALL_RADIUS <= 0 || s_ballY + BALL_RADIUS >= s_ballArea.y) {
+    s_ballVelY *= -1;
+    s_ballY = (s_ballY - BALL_RADIUS <= 0) ? BALL_RADIUS : s_ballArea.y - BALL_RADIUS;
+  }
+}
+
+static void bouncingBallWindow() {
   float app_w = sapp_widthf();
   float app_h = sapp_heightf();
   igSetNextWindowPos((ImVec2){app_w * 0.7f, app_h * 0.05f}, ImGuiCond_Once, (ImVec2){0, 0});
@@ -565,6 +473,7 @@ static void bouncingBallWindow() {
     igGetCursorScreenPos(&p);
     ImVec2 win_size;
     igGetContentRegionAvail(&win_size);
+    s_ballArea = win_size;
 
     // Draw white borders (4 rectangles)
     float border_thickness = 4.0f;
@@ -597,28 +506,13 @@ static void bouncingBallWindow() {
         0.0f,
         0); // Right
 
-    // Update ball position
-    ball_x += velocity_x;
-    ball_y += velocity_y;
-
-    // Ball radius
-    float radius = 10.0f;
-
-    // Bounce logic for X
-    if (ball_x - radius <= 0 || ball_x + radius >= win_size.x) {
-      velocity_x *= -1;
-      ball_x = (ball_x - radius <= 0) ? radius : win_size.x - radius;
-    }
-
-    // Bounce logic for Y
-    if (ball_y - radius <= 0 || ball_y + radius >= win_size.y) {
-      velocity_y *= -1;
-      ball_y = (ball_y - radius <= 0) ? radius : win_size.y - radius;
-    }
-
     // Draw the ball
     ImDrawList_AddCircleFilled(
-        draw_list, (ImVec2){p.x + ball_x, p.y + ball_y}, radius, IM_COL32(0, 255, 0, 255), 12);
+        draw_list,
+        (ImVec2){p.x + s_ballX, p.y + s_ballY},
+        BALL_RADIUS,
+        IM_COL32(0, 255, 0, 255),
+        12);
   }
   igEnd();
 }
@@ -647,10 +541,14 @@ static ImU32 s_colors[] = {
     IM_COL32(0, 255, 0, 255),
     IM_COL32(255, 255, 255, 255)};
 
+/// Random numbers for one update of the whole spreadsheet, drawn in bulk.
+static float s_steps[NUM_ROWS][NUM_COLS];
+
 static void randomizeNumbers() {
+  s_uiRng.fill(&s_steps[0][0], NUM_ROWS * NUM_COLS);
   for (int i = 0; i < NUM_ROWS; ++i) {
     for (int j = 0; j < NUM_COLS; ++j) {
-      s_numbers[i][j] += ((float)rand() / RAND_MAX - 0.5) * 2; // Random step
+      s_numbers[i][j] += (s_steps[i][j] - 0.5f) * 2; // Random step
       if (s_numbers[i][j] < 0)
         s_numbers[i][j] = 0;
       if (s_numbers[i][j] > 100)
@@ -667,16 +565,22 @@ static ImU32 getColor(float num) {
   return s_colors[2];
 }
 
-void renderSpreadsheet(const char *name, double curTime) {
+/// The text and color of every cell, formatted by a job.
+static char s_cellText[NUM_ROWS][NUM_COLS][16];
+static ImU32 s_cellColors[NUM_ROWS][NUM_COLS];
+
+/// Step the numbers once a second. Runs as a job.
+static void updateSpreadsheet(double curTime) {
   static bool inited = false;
   static double lastTime = 0;
 
   if (!inited) {
     inited = true;
     // Initialize numbers to random values between 0 and 100
+    s_uiRng.fill(&s_numbers[0][0], NUM_ROWS * NUM_COLS);
     for (int i = 0; i < NUM_ROWS; ++i) {
       for (int j = 0; j < NUM_COLS; ++j) {
-        s_numbers[i][j] = (float)rand() / RAND_MAX * 100.0f;
+        s_numbers[i][j] *= 100.0f;
       }
     }
   }
@@ -685,7 +589,19 @@ void renderSpreadsheet(const char *name, double curTime) {
     lastTime = curTime;
     randomizeNumbers();
   }
+}
 
+/// Format the numbers left by updateSpreadsheet(). Runs as a job.
+static void formatSpreadsheet() {
+  for (int row = 0; row < NUM_ROWS; ++row) {
+    for (int col = 0; col < NUM_COLS; ++col) {
+      snprintf(s_cellText[row][col], sizeof(s_cellText[row][col]), "%.2f", s_numbers[row][col]);
+      s_cellColors[row][col] = getColor(s_numbers[row][col]);
+    }
+  }
+}
+
+void renderSpreadsheet(const char *name) {
   if (igBegin(name, NULL, 0)) {
     if (igBeginTable("spreadsheet", NUM_COLS + 1, ImGuiTableFlags_Resizable, (ImVec2){0, 0}, 0)) {
       igTableSetupColumn("Labels", ImGuiTableColumnFlags_WidthFixed, 0, 0);
@@ -703,10 +619,10 @@ void renderSpreadsheet(const char *name, double curTime) {
         for (int col = 0; col < NUM_COLS; ++col) {
           igTableSetColumnIndex(col + 1);
 
-          ImU32 color = getColor(s_numbers[row][col]);
+          ImU32 color = s_cellColors[row][col];
           igPushStyleColor_U32(ImGuiCol_Text, color);
           //          igTableSetBgColor(ImGuiTableBgTarget_CellBg, color, col);
-          igText("%.2f", s_numbers[row][col]);
+          igTextUnformatted(s_cellText[row][col], nullptr);
           igPopStyleColor(1);
         }
       }
@@ -718,47 +634,86 @@ void renderSpreadsheet(const char *name, double curTime) {
 
 void app_frame() {
   uint64_t now = stm_now();
+  s_profiler.beginFrame();
 
   if (!s_started) {
     s_started = true;
     s_start_time = now;
-    s_last_fps_time = now;
-    s_frame_count = 0;
-  } else {
-    ++s_frame_count;
-    // Update FPS every second
-    uint64_t diff = stm_diff(now, s_last_fps_time);
-    if (diff > 1000000000) {
-      s_fps = s_frame_count / stm_sec(diff);
-      s_frame_count = 0;
-      s_last_fps_time = now;
-    }
-  }
-
-  simgui_new_frame({
-      .width = sapp_width(),
-      .height = sapp_height(),
-      .delta_time = sapp_frame_duration(),
-      .dpi_scale = sapp_dpi_scale(),
-  });
-  chooseColorWindow();
-  gameWindow(now);
-  bouncingBallWindow();
-  renderSpreadsheet("Cities", stm_sec(stm_diff(now, s_start_time)));
-
-  if (s_fps) {
-    sdtx_canvas((float)sapp_width(), (float)sapp_height());
-    sdtx_printf("FPS: %d", (int)(s_fps + 0.5));
-  }
+    if (!s_replayPath)
+      s_sim.start(s_start_time);
+  }
+
+  float renderDT;
+  const GameSnapshot &game = advanceGame(now, &renderDT);
+  s_latency.rendered(game.tick);
+
+  // The work of the windows that doesn't need ImGui runs as jobs, and is
+  // joined before the UI is built. The spreadsheet is formatted after it is
+  // updated; the rest is independent.
+  {
+    ScopedStage stage(s_profiler, STAGE_JOBS);
+    double curTime = stm_sec(stm_diff(now, s_start_time));
+    JobSystem::JobHandle gameJob =
+        s_jobs->submit([&] { prepare_game_render(game, renderDT, s_gameRender, s_jobs.get()); });
+    JobSystem::JobHandle ballJob = s_jobs->submit(moveBall);
+    JobSystem::JobHandle updateJob = s_jobs->submit([curTime] { updateSpreadsheet(curTime); });
+    JobSystem::JobHandle formatJob = s_jobs->submit(formatSpreadsheet, {updateJob});
+    s_jobs->wait(gameJob);
+    s_jobs->wait(ballJob);
+    s_jobs->wait(formatJob);
+  }
+
+  {
+    ScopedStage stage(s_profiler, STAGE_IMGUI);
+    simgui_new_frame({
+        .width = sapp_width(),
+        .height = sapp_height(),
+        .delta_time = sapp_frame_duration(),
+        .dpi_scale = sapp_dpi_scale(),
+    });
+    chooseColorWindow();
+    gameWindow();
+    bouncingBallWindow();
+    renderSpreadsheet("Cities");
+  }
+
+  sdtx_canvas((float)sapp_width(), (float)sapp_height());
+  s_profiler.printOverlay();
+  // Stats of the previous frame's simgui_render().
+  simgui_frame_stats_t uiStats = simgui_query_frame_stats();
+  sdtx_printf(
+      "UI: %d vtx, %.1f KB uploaded, %.1f KB buffers\n",
+      uiStats.num_vertices,
+      uiStats.total_bytes / 1024.0,
+      uiStats.buffer_bytes / 1024.0);
+  if (s_sim.running()) {
+    sdtx_printf(
+        "Sim: %llu ticks, %llu dropped, %llu late\n",
+        (unsigned long long)s_sim.ticks(),
+        (unsigned long long)s_sim.dropped(),
+        (unsigned long long)s_sim.late());
+  }
+  s_latency.printOverlay();
 
   // Begin and end pass
   sg_begin_default_pass(&s_pass_action, sapp_width(), sapp_height());
-  simgui_render();
-  sdtx_draw();
+  {
+    ScopedStage stage(s_profiler, STAGE_SIMGUI_RENDER);
+    simgui_render();
+  }
+  {
+    ScopedStage stage(s_profiler, STAGE_SDTX);
+    sdtx_draw();
+  }
   sg_end_pass();
 
   // Commit the frame
-  sg_commit();
+  {
+    ScopedStage stage(s_profiler, STAGE_COMMIT);
+    sg_commit();
+  }
+  s_latency.committed();
+  s_profiler.endFrame();
 }
 
 static sapp_desc make_sapp_desc() {
@@ -775,5 +730,14 @@ static sapp_desc make_sapp_desc() {
 }
 
 sapp_desc sokol_main(int argc, char *argv[]) {
+  s_seed = game_default_seed();
+  for (int i = 1; i < argc; ++i) {
+    if (strncmp(argv[i], "--seed=", 7) == 0)
+      s_seed = strtoull(argv[i] + 7, nullptr, 0);
+    else if (strncmp(argv[i], "--record=", 9) == 0)
+      s_recordPath = argv[i] + 9;
+    else if (strncmp(argv[i], "--replay=", 9) == 0)
+      s_replayPath = argv[i] + 9;
+  }
   return make_sapp_desc();
 }
@@ -4,6 +4,29 @@ const _get_bg_color = $SHBuiltin.extern_c({}, function get_bg_color(): c_ptr {
     throw 0;
 });
 
+// Timing of the frame stages that run in JS, shown in the overlay and in frame
+// traces. The stage numbers match enum Stage in scroller.cpp.
+const _frame_stage_begin = $SHBuiltin.extern_c({}, function frame_stage_begin(stage: c_int): void {
+});
+const _frame_stage_end = $SHBuiltin.extern_c({}, function frame_stage_end(stage: c_int): void {
+});
+const STAGE_SIM = 0;
+
+// Batched drawing of the game layer, see draw_commands.h.
+const _set_draw_transform = $SHBuiltin.extern_c({include: "draw_commands.h"}, function set_draw_transform(org_x: c_float, org_y: c_float, scale_x: c_float, scale_y: c_float): void {
+});
+const _flush_draw_commands = $SHBuiltin.extern_c({include: "draw_commands.h"}, function flush_draw_commands(cmds: c_ptr, count: c_int): void {
+});
+
+const _getenv_int = $SHBuiltin.extern_c({}, function getenv_int(name: c_ptr, defaultValue: c_int, min: c_int, max: c_int): c_int {
+    return 0;
+});
+const _getenv_double = $SHBuiltin.extern_c({}, function getenv_double(name: c_ptr, defaultValue: c_double, min: c_double, max: c_double): c_double {
+    return 0;
+});
+const _exit = $SHBuiltin.extern_c({include: "stdlib.h"}, function exit(status: c_int): void {
+});
+
 const _load_image = $SHBuiltin.extern_c({}, function load_image(path: c_ptr): c_int {
     return 0;
 });
@@ -22,6 +45,8 @@ class Image {
     width: number;
     height: number;
     simguiImage: c_ptr;
+    /// The id of simguiImage, for DRAW_CMD_BLIT.
+    simguiImageId: number;
 
     constructor(path: string) {
         let path_z = stringToAsciiz(path);
@@ -33,6 +58,7 @@ class Image {
         this.width = _image_width(this.handle);
         this.height = _image_height(this.handle);
         this.simguiImage = _image_simgui_image(this.handle);
+        this.simguiImageId = get_simgui_image_t_id(this.simguiImage);
     }
 }
 
@@ -56,6 +82,9 @@ let s_winSize_x = 0;
 let s_winSize_y = 0;
 let s_scale_x = 0;
 let s_scale_y = 0;
+// The game window reads its position and size into temporary memory through
+// this view, which inlines the field reads at constant offsets.
+const s_tmpVec = new ImVec2View(c_null);
 
 function mathRandom(range: number): number {
     "inline";
@@ -67,69 +96,54 @@ function IM_COL32(r, g, b, a) {
     return ((a & 0xFF) << 24) | ((b & 0xFF) << 16) | ((g & 0xFF) << 8) | (r & 0xFF);
 }
 
-const s_vecs = calloc(_sizeof_ImVec2 * 4);
-
-function pushRectImage(x: number, y: number, w: number, h: number, img: c_ptr): void {
-    x = x * s_scale_x + s_winOrg_x;
-    y = y * s_scale_y + s_winOrg_y;
-    w *= s_scale_x;
-    h *= s_scale_y;
-
-    // min
-    set_ImVec2_x(s_vecs, x);
-    set_ImVec2_y(s_vecs, y);
-    // max
-    set_ImVec2_x(_sh_ptr_add(s_vecs, _sizeof_ImVec2), x + w);
-    set_ImVec2_y(_sh_ptr_add(s_vecs, _sizeof_ImVec2), y + h);
-    // uv_min
-    set_ImVec2_x(_sh_ptr_add(s_vecs, 2 * _sizeof_ImVec2), 0);
-    set_ImVec2_y(_sh_ptr_add(s_vecs, 2 * _sizeof_ImVec2), 0);
-    // uv_max
-    set_ImVec2_x(_sh_ptr_add(s_vecs, 3 * _sizeof_ImVec2), 1);
-    set_ImVec2_y(_sh_ptr_add(s_vecs, 3 * _sizeof_ImVec2), 1);
-
-    _ImDrawList_AddImage(
-        _igGetWindowDrawList(),
-        _simgui_imtextureid(img),
-        s_vecs,
-        _sh_ptr_add(s_vecs, _sizeof_ImVec2),
-        _sh_ptr_add(s_vecs, _sizeof_ImVec2 * 2),
-        _sh_ptr_add(s_vecs, _sizeof_ImVec2 * 3),
-        IM_COL32(255, 255, 255, 255)
-    );
+// The layout of DrawCommand in draw_commands.h, in 32-bit words.
+const DRAW_CMD_FILL = 0;
+const DRAW_CMD_BLIT = 1;
+const DRAW_CMD_WORDS = 8;
+const DRAW_CMD_OP = 0;
+const DRAW_CMD_TEXTURE = 1;
+const DRAW_CMD_COLOR = 2;
+const DRAW_CMD_X = 3;
+const DRAW_CMD_Y = 4;
+const DRAW_CMD_W = 5;
+const DRAW_CMD_H = 6;
+
+/// Commands per flush. The buffer is flushed early if a frame draws more.
+const DRAW_CMD_CAPACITY = 4096;
+const s_drawCmds = nativeAlloc(DRAW_CMD_CAPACITY * DRAW_CMD_WORDS * 4);
+// Two views of the same memory, for the integer and the float fields.
+const s_drawCmdsI32 = nativeInt32Array(s_drawCmds, DRAW_CMD_CAPACITY * DRAW_CMD_WORDS);
+const s_drawCmdsF32 = nativeFloat32Array(s_drawCmds, DRAW_CMD_CAPACITY * DRAW_CMD_WORDS);
+let s_drawCmdCount = 0;
+
+function flushDrawCommands(): void {
+    _flush_draw_commands(s_drawCmds, s_drawCmdCount);
+    s_drawCmdCount = 0;
 }
 
-function pushRectWithColor(x: number, y: number, w: number, h: number, r: number, g: number, b: number, a: number): void {
-    x = x * s_scale_x + s_winOrg_x;
-    y = y * s_scale_y + s_winOrg_y;
-    w *= s_scale_x;
-    h *= s_scale_y;
-
-    // min
-    set_ImVec2_x(s_vecs, x);
-    set_ImVec2_y(s_vecs, y);
-    // max
-    set_ImVec2_x(_sh_ptr_add(s_vecs, _sizeof_ImVec2), x + w);
-    set_ImVec2_y(_sh_ptr_add(s_vecs, _sizeof_ImVec2), y + h);
-
-    _ImDrawList_AddRectFilled(
-        _igGetWindowDrawList(),
-        s_vecs,
-        _sh_ptr_add(s_vecs, _sizeof_ImVec2),
-        IM_COL32(255 * r, 255 * g, 255 * b, 255 * a),
-        0.0,
-        0
-    );
+function pushDrawCommand(op: number, texture: number, color: number, x: number, y: number, w: number, h: number): void {
+    "inline";
+    if (s_drawCmdCount === DRAW_CMD_CAPACITY)
+        flushDrawCommands();
+    const base = s_drawCmdCount * DRAW_CMD_WORDS;
+    ++s_drawCmdCount;
+    s_drawCmdsI32[base + DRAW_CMD_OP] = op;
+    s_drawCmdsI32[base + DRAW_CMD_TEXTURE] = texture;
+    s_drawCmdsI32[base + DRAW_CMD_COLOR] = color;
+    s_drawCmdsF32[base + DRAW_CMD_X] = x;
+    s_drawCmdsF32[base + DRAW_CMD_Y] = y;
+    s_drawCmdsF32[base + DRAW_CMD_W] = w;
+    s_drawCmdsF32[base + DRAW_CMD_H] = h;
 }
 
 function drawFillPx(x: number, y: number, w: number, h: number, r: number, g: number, b: number, a: number): void {
     "inline";
-    pushRectWithColor(x, y, w, h, r, g, b, a);
+    pushDrawCommand(DRAW_CMD_FILL, 0, IM_COL32(255 * r, 255 * g, 255 * b, 255 * a), x, y, w, h);
 }
 
 function drawBlitPx(image: Image, x: number, y: number, w: number, h: number): void {
     "inline";
-    pushRectImage(x, y, w, h, image.simguiImage);
+    pushDrawCommand(DRAW_CMD_BLIT, image.simguiImageId, IM_COL32(255, 255, 255, 255), x, y, w, h);
 }
 
 class Actor {
@@ -436,8 +450,11 @@ function gameWindow(app_w: number, app_h: number, render_time: number): void {
         if (save)
             s_last_game_time = s_game_time;
         s_game_time += PHYS_DT;
-        if (!s_pause)
+        if (!s_pause) {
+            _frame_stage_begin(STAGE_SIM);
             update_game_state(save);
+            _frame_stage_end(STAGE_SIM);
+        }
         save = false;
     }
 
@@ -445,27 +462,25 @@ function gameWindow(app_w: number, app_h: number, render_time: number): void {
         ? (render_time - s_last_game_time) / (s_game_time - s_last_game_time)
         : 0;
 
-    let tmpVec = allocTmp(_sizeof_ImVec2 * 2);
-    set_ImVec2_x(tmpVec, app_w * 0.55);
-    set_ImVec2_y(tmpVec, app_h * 0.6);
-    _igSetNextWindowPos(tmpVec, _ImGuiCond_Once, _sh_ptr_add(tmpVec, _sizeof_ImVec2));
-    set_ImVec2_x(tmpVec, app_w * 0.35);
-    set_ImVec2_y(tmpVec, app_h * 0.35);
-    _igSetNextWindowSize(tmpVec, _ImGuiCond_Once);
+    _igSetNextWindowPos(app_w * 0.55, app_h * 0.6, _ImGuiCond_Once, 0, 0);
+    _igSetNextWindowSize(app_w * 0.35, app_h * 0.35, _ImGuiCond_Once);
+    s_tmpVec.ptr = allocTmp(_sizeof_ImVec2);
 
-    if (_igBegin(tmpAsciiz("Game"), c_null, 0)) {
+    if (_igBegin(internAsciiz("Game"), c_null, 0)) {
         // Get the top-left corner and size of the window
-        _igGetCursorScreenPos(tmpVec);
-        s_winOrg_x = get_ImVec2_x(tmpVec);
-        s_winOrg_y = get_ImVec2_y(tmpVec);
-        _igGetContentRegionAvail(tmpVec);
-        s_winSize_x = get_ImVec2_x(tmpVec);
-        s_winSize_y = get_ImVec2_y(tmpVec);
+        _igGetCursorScreenPos(s_tmpVec.ptr);
+        s_winOrg_x = s_tmpVec.get_x();
+        s_winOrg_y = s_tmpVec.get_y();
+        _igGetContentRegionAvail(s_tmpVec.ptr);
+        s_winSize_x = s_tmpVec.get_x();
+        s_winSize_y = s_tmpVec.get_y();
 
         s_scale_x = s_winSize_x * INV_ASSUMED_W;
         s_scale_y = s_winSize_y * INV_ASSUMED_H;
 
+        _set_draw_transform(s_winOrg_x, s_winOrg_y, s_scale_x, s_scale_y);
         render_game_frame(renderDT);
+        flushDrawCommands();
     }
     _igEnd();
 }
@@ -475,22 +490,12 @@ const s_text = calloc(s_text_size);
 copyToAsciiz("This is some text for editing.\nAnd more.", s_text, s_text_size);
 
 function chooseColorWindow() {
-    // Create ImVec2 buffer for window position and size
-    const vec2Buffer = allocTmp(_sizeof_ImVec2);
-
-    // Setup and use as pos
-    set_ImVec2_x(vec2Buffer, 10);
-    set_ImVec2_y(vec2Buffer, 10);
-    _igSetNextWindowPos(vec2Buffer, _ImGuiCond_Once, allocTmp(_sizeof_ImVec2));
-
-    // Setup and use as size
-    set_ImVec2_x(vec2Buffer, 400);
-    set_ImVec2_y(vec2Buffer, 200);
-    _igSetNextWindowSize(vec2Buffer, _ImGuiCond_Once);
-
-    _igBegin(tmpAsciiz("Settings"), c_null, _ImGuiWindowFlags_None);
-    _igColorEdit3(tmpAsciiz("Bg"), _get_bg_color(), _ImGuiColorEditFlags_None);
-    _igInputTextMultiline(tmpAsciiz("Text"), s_text, s_text_size, allocTmp(_sizeof_ImVec2), 0, c_null, c_null);
+    _igSetNextWindowPos(10, 10, _ImGuiCond_Once, 0, 0);
+    _igSetNextWindowSize(400, 200, _ImGuiCond_Once);
+
+    _igBegin(internAsciiz("Settings"), c_null, _ImGuiWindowFlags_None);
+    _igColorEdit3(internAsciiz("Bg"), _get_bg_color(), _ImGuiColorEditFlags_None);
+    _igInputTextMultiline(internAsciiz("Text"), s_text, s_text_size, 0, 0, 0, c_null, c_null);
     _igEnd();
 }
 
@@ -501,19 +506,10 @@ let velocity_y = 1.5;
 
 function bouncingBallWindow(app_w: number, app_h: number) {
     // Window Position and Size
-    const vec2Buffer = allocTmp(_sizeof_ImVec2);
-
-    // Set next window pos
-    set_ImVec2_x(vec2Buffer, app_w * 0.7);
-    set_ImVec2_y(vec2Buffer, app_h * 0.05);
-    _igSetNextWindowPos(vec2Buffer, _ImGuiCond_Once, allocTmp(_sizeof_ImVec2));
+    _igSetNextWindowPos(app_w * 0.7, app_h * 0.05, _ImGuiCond_Once, 0, 0);
+    _igSetNextWindowSize(app_w * 0.3, app_h * 0.3, _ImGuiCond_Once);
 
-    // Set next window size
-    set_ImVec2_x(vec2Buffer, app_w * 0.3);
-    set_ImVec2_y(vec2Buffer, app_h * 0.3);
-    _igSetNextWindowSize(vec2Buffer, _ImGuiCond_Once);
-
-    if (_igBegin(tmpAsciiz("Bouncing Ball"), c_null, 0)) {
+    if (_igBegin(internAsciiz("Bouncing Ball"), c_null, 0)) {
         // Draw List
         const draw_list = _igGetWindowDrawList();
 
@@ -522,15 +518,19 @@ function bouncingBallWindow(app_w: number, app_h: number) {
         const win_size = allocTmp(_sizeof_ImVec2);
         _igGetCursorScreenPos(p);
         _igGetContentRegionAvail(win_size);
+        const px = get_ImVec2_x(p);
+        const py = get_ImVec2_y(p);
+        const ww = get_ImVec2_x(win_size);
+        const wh = get_ImVec2_y(win_size);
 
         // Draw borders
         const white = IM_COL32(255, 255, 255, 255);
         const border_thickness = 4.0;
 
-        _ImDrawList_AddRectFilled(draw_list, p, addVectors(p, get_ImVec2_x(win_size), border_thickness), white, 0, 0);
-        _ImDrawList_AddRectFilled(draw_list, p, addVectors(p, border_thickness, get_ImVec2_y(win_size)), white, 0, 0);
-        _ImDrawList_AddRectFilled(draw_list, addVectors(p, 0, get_ImVec2_y(win_size) - border_thickness), addVectors2(p, win_size), white, 0, 0);
-        _ImDrawList_AddRectFilled(draw_list, addVectors(p, get_ImVec2_x(win_size) - border_thickness, 0), addVectors2(p, win_size), white, 0, 0);
+        _ImDrawList_AddRectFilled(draw_list, px, py, px + ww, py + border_thickness, white, 0, 0);
+        _ImDrawList_AddRectFilled(draw_list, px, py, px + border_thickness, py + wh, white, 0, 0);
+        _ImDrawList_AddRectFilled(draw_list, px, py + wh - border_thickness, px + ww, py + wh, white, 0, 0);
+        _ImDrawList_AddRectFilled(draw_list, px + ww - border_thickness, py, px + ww, py + wh, white, 0, 0);
 
         // Update ball
         ball_x += velocity_x;
@@ -539,38 +539,23 @@ function bouncingBallWindow(app_w: number, app_h: number) {
         const radius = 10.0;
 
         // Bounce X
-        if (ball_x - radius <= 0 || ball_x + radius >= get_ImVec2_x(win_size)) {
+        if (ball_x - radius <= 0 || ball_x + radius >= ww) {
             velocity_x *= -1;
-            ball_x = (ball_x - radius <= 0) ? radius : get_ImVec2_x(win_size) - radius;
+            ball_x = (ball_x - radius <= 0) ? radius : ww - radius;
         }
 
         // Bounce Y
-        if (ball_y - radius <= 0 || ball_y + radius >= get_ImVec2_y(win_size)) {
+        if (ball_y - radius <= 0 || ball_y + radius >= wh) {
             velocity_y *= -1;
-            ball_y = (ball_y - radius <= 0) ? radius : get_ImVec2_y(win_size) - radius;
+            ball_y = (ball_y - radius <= 0) ? radius : wh - radius;
         }
 
         // Draw ball
-        _ImDrawList_AddCircleFilled(draw_list, addVectors(p, ball_x, ball_y), radius, IM_COL32(0, 255, 0, 255), 12);
+        _ImDrawList_AddCircleFilled(draw_list, px + ball_x, py + ball_y, radius, IM_COL32(0, 255, 0, 255), 12);
     }
     _igEnd();
 }
 
-// Helper function for adding vectors
-function addVectors(v1: c_ptr, x: number, y: number): c_ptr {
-    const newVec = allocTmp(_sizeof_ImVec2);
-    set_ImVec2_x(newVec, get_ImVec2_x(v1) + x);
-    set_ImVec2_y(newVec, get_ImVec2_y(v1) + y);
-    return newVec;
-}
-
-function addVectors2(v1: c_ptr, v2: c_ptr): c_ptr {
-    const newVec = allocTmp(_sizeof_ImVec2);
-    set_ImVec2_x(newVec, get_ImVec2_x(v1) + get_ImVec2_x(v2));
-    set_ImVec2_y(newVec, get_ImVec2_y(v1) + get_ImVec2_y(v2));
-    return newVec;
-}
-
 const NUM_ROWS = 40;
 const NUM_COLS = 8;
 let s_numbers = Array.from({length: NUM_ROWS}, () => new Float32Array(NUM_COLS));
@@ -606,6 +591,24 @@ function randomizeNumbers() {
     }
 }
 
+// ASCIIZ text of the cells, re-encoded only when the numbers change rather
+// than every frame. "100.00" plus the terminator fits in 8 bytes.
+const CELL_TEXT_SIZE = 8;
+const s_cellText = calloc(NUM_ROWS * NUM_COLS * CELL_TEXT_SIZE);
+
+function cellText(row: number, col: number): c_ptr {
+    "inline";
+    return _sh_ptr_add(s_cellText, (row * NUM_COLS + col) * CELL_TEXT_SIZE);
+}
+
+function encodeCells(): void {
+    for (let i = 0; i < NUM_ROWS; ++i) {
+        for (let j = 0; j < NUM_COLS; ++j) {
+            copyToAsciiz(s_numbers[i][j].toFixed(2), cellText(i, j), CELL_TEXT_SIZE);
+        }
+    }
+}
+
 let inited = false;
 let lastTime = 0;
 
@@ -617,44 +620,38 @@ function renderSpreadsheet(name: string, app_w: number, app_h: number, curTime:
                 s_numbers[i][j] = Math.random() * 100;
             }
         }
+        encodeCells();
     }
 
     if (curTime - lastTime >= 1) {
         lastTime = curTime;
         randomizeNumbers();
+        encodeCells();
     }
 
     // Window Position and Size
-    const vec2Buffer = allocTmp(_sizeof_ImVec2);
+    _igSetNextWindowPos(100, 150, _ImGuiCond_Once, 0, 0);
+    _igSetNextWindowSize(512, 540, _ImGuiCond_Once);
 
-    set_ImVec2_x(vec2Buffer, 100);
-    set_ImVec2_y(vec2Buffer, 150);
-    _igSetNextWindowPos(vec2Buffer, _ImGuiCond_Once, allocTmp(_sizeof_ImVec2));
-
-    // Set next window size
-    set_ImVec2_x(vec2Buffer, 512);
-    set_ImVec2_y(vec2Buffer, 540);
-    _igSetNextWindowSize(vec2Buffer, _ImGuiCond_Once);
-
-    if (_igBegin(tmpAsciiz(name), c_null, 0)) {
-        if (_igBeginTable(tmpAsciiz("spreadsheet"), NUM_COLS + 1, _ImGuiTableFlags_Resizable, allocTmp(_sizeof_ImVec2), 0)) {
-            _igTableSetupColumn(tmpAsciiz("Labels"), _ImGuiTableColumnFlags_WidthFixed, 0, 0);
+    if (_igBegin(internAsciiz(name), c_null, 0)) {
+        if (_igBeginTable(internAsciiz("spreadsheet"), NUM_COLS + 1, _ImGuiTableFlags_Resizable, 0, 0, 0)) {
+            _igTableSetupColumn(internAsciiz("Labels"), _ImGuiTableColumnFlags_WidthFixed, 0, 0);
             for (let i = 0; i < NUM_COLS; ++i) {
-                _igTableSetupColumn(tmpAsciiz("Column"), _ImGuiTableColumnFlags_WidthStretch, 0, 0);
+                _igTableSetupColumn(internAsciiz("Column"), _ImGuiTableColumnFlags_WidthStretch, 0, 0);
             }
             _igTableHeadersRow();
 
             for (let row = 0; row < NUM_ROWS; ++row) {
                 _igTableNextRow(_ImGuiTableRowFlags_None, 0);
                 _igTableSetColumnIndex(0);
-                _igText(tmpAsciiz(s_capitals[row % s_capitals.length]));
+                _igText(internAsciiz(s_capitals[row % s_capitals.length]));
 
                 for (let col = 0; col < NUM_COLS; ++col) {
                     _igTableSetColumnIndex(col + 1);
 
                     let color = getColor(s_numbers[row][col]);
                     _igPushStyleColor_U32(_ImGuiCol_Text, color);
-                    _igText(tmpAsciiz(s_numbers[row][col].toFixed(2)));
+                    _igText(cellText(row, col));
                     _igPopStyleColor(1);
                 }
             }
@@ -664,23 +661,51 @@ function renderSpreadsheet(name: string, app_w: number, app_h: number, curTime:
     }
 }
 
-let nbody_advance = nbodyRunner();
+// NBODY_N=n simulates n bodies instead of the Sun and the outer planets, up to
+// 10000 in JS and 1000000 natively. NBODY_SOA=1 uses the typed-array engine
+// instead of Body objects. NBODY_SIM=1 runs the multithreaded native simulation
+// with the direct sum, NBODY_SIM=2 with Barnes-Hut, whose accuracy is set by
+// NBODY_THETA (0 to 2, 0.5 by default). NBODY_THREADS limits the number of
+// threads, up to NBODY_MAX_THREADS.
+const NBODY_SIM = _getenv_int(internAsciiz("NBODY_SIM"), 0, 0, 2);
+const NBODY_N = Math.min(
+    Math.max(_getenv_int(internAsciiz("NBODY_N"), 5, 0, 1000000000), 5),
+    NBODY_SIM !== 0 ? 1000000 : 10000);
+const NBODY_USE_SOA = _getenv_int(internAsciiz("NBODY_SOA"), 0, 0, 1) !== 0;
+// Draw at most this many asteroids, evenly spread over all of them.
+const NBODY_MAX_DRAWN = 20000;
+
+const s_nbodySoA = new NBodySoA(NBODY_N);
+const s_nbodyBodies: Body[] = NBODY_SIM === 0 && !NBODY_USE_SOA ? s_nbodySoA.toBodies() : [];
+const nbody_advance = nbodyRunner(s_nbodyBodies);
+const s_nbodySim: c_ptr = NBODY_SIM !== 0
+    ? _nbody_sim_create(
+        s_nbodySoA.state, NBODY_N, _getenv_int(internAsciiz("NBODY_THREADS"), 0, 0, NBODY_MAX_THREADS))
+    : c_null;
+if (NBODY_SIM !== 0) {
+    _nbody_sim_set_mode(
+        s_nbodySim,
+        NBODY_SIM === 2 ? NBODY_BARNES_HUT : NBODY_DIRECT,
+        _getenv_double(internAsciiz("NBODY_THETA"), 0.5, 0, 2));
+}
+// The positions to draw: the typed-array engine's own, or copied from
+// s_nbodyBodies, or from s_nbodySim into native memory.
+const s_nbodyPositions: c_ptr = NBODY_SIM !== 0 ? nativeAlloc(2 * NBODY_N * 8) : c_null;
+const s_nbodyX = NBODY_SIM !== 0
+    ? nativeFloat64Array(s_nbodyPositions, NBODY_N)
+    : NBODY_USE_SOA ? s_nbodySoA.x : new Float64Array(NBODY_N);
+const s_nbodyY = NBODY_SIM !== 0
+    ? nativeFloat64Array(_sh_ptr_add(s_nbodyPositions, NBODY_N * 8), NBODY_N)
+    : NBODY_USE_SOA ? s_nbodySoA.y : new Float64Array(NBODY_N);
+// For the colors of the first bodies.
+const s_nbodyPlanets: Body[] = nbodyPlanets();
 
 function nbodyWindow(app_w: number, app_h: number) {
     // Window Position and Size
-    const vec2Buffer = allocTmp(_sizeof_ImVec2);
+    _igSetNextWindowPos(app_w * 0.05, app_h * 0.50, _ImGuiCond_Once, 0, 0);
+    _igSetNextWindowSize(app_w * 0.45, app_h * 0.45, _ImGuiCond_Once);
 
-    // Set next window pos
-    set_ImVec2_x(vec2Buffer, app_w * 0.05);
-    set_ImVec2_y(vec2Buffer, app_h * 0.50);
-    _igSetNextWindowPos(vec2Buffer, _ImGuiCond_Once, allocTmp(_sizeof_ImVec2));
-
-    // Set next window size
-    set_ImVec2_x(vec2Buffer, app_w * 0.45);
-    set_ImVec2_y(vec2Buffer, app_h * 0.45);
-    _igSetNextWindowSize(vec2Buffer, _ImGuiCond_Once);
-
-    if (_igBegin(tmpAsciiz("nbody"), c_null, 0)) {
+    if (_igBegin(internAsciiz("nbody"), c_null, 0)) {
         // Draw List
         const draw_list = _igGetWindowDrawList();
 
@@ -689,36 +714,51 @@ function nbodyWindow(app_w: number, app_h: number) {
         const win_size = allocTmp(_sizeof_ImVec2);
         _igGetCursorScreenPos(p);
         _igGetContentRegionAvail(win_size);
+        const px = get_ImVec2_x(p);
+        const py = get_ImVec2_y(p);
+        const ww = get_ImVec2_x(win_size);
+        const wh = get_ImVec2_y(win_size);
 
         // Draw borders
         const white = IM_COL32(255, 255, 255, 255);
         const border_thickness = 4.0;
 
-        _ImDrawList_AddRectFilled(draw_list, p, addVectors(p, get_ImVec2_x(win_size), border_thickness), white, 0, 0);
-        _ImDrawList_AddRectFilled(draw_list, p, addVectors(p, border_thickness, get_ImVec2_y(win_size)), white, 0, 0);
-        _ImDrawList_AddRectFilled(draw_list, addVectors(p, 0, get_ImVec2_y(win_size) - border_thickness), addVectors2(p, win_size), white, 0, 0);
-        _ImDrawList_AddRectFilled(draw_list, addVectors(p, get_ImVec2_x(win_size) - border_thickness, 0), addVectors2(p, win_size), white, 0, 0);
+        _ImDrawList_AddRectFilled(draw_list, px, py, px + ww, py + border_thickness, white, 0, 0);
+        _ImDrawList_AddRectFilled(draw_list, px, py, px + border_thickness, py + wh, white, 0, 0);
+        _ImDrawList_AddRectFilled(draw_list, px, py + wh - border_thickness, px + ww, py + wh, white, 0, 0);
+        _ImDrawList_AddRectFilled(draw_list, px + ww - border_thickness, py, px + ww, py + wh, white, 0, 0);
 
         // Update bodies.
         const dt = 0.01;
-        const bodies: Body[] = nbody_advance(dt);
-
+        const n = NBODY_N;
+        const xs = s_nbodyX;
+        const ys = s_nbodyY;
+        if (NBODY_SIM !== 0) {
+            _nbody_sim_step(s_nbodySim, dt, 1);
+            _nbody_sim_positions(s_nbodySim, s_nbodyPositions, _sh_ptr_add(s_nbodyPositions, n * 8));
+        } else if (NBODY_USE_SOA) {
+            s_nbodySoA.advance(dt);
+        } else {
+            const bodies: Body[] = nbody_advance(dt);
+            for (let i = 0; i < n; ++i) {
+                xs[i] = bodies[i].x;
+                ys[i] = bodies[i].y;
+            }
+        }
 
         // Calculate bounds.
-        const win_x = get_ImVec2_x(win_size);
-        const win_y = get_ImVec2_y(win_size);
-
-        let max_x = bodies[0].x;
-        let max_y = bodies[0].y;
+        let max_x = xs[0];
+        let max_y = ys[0];
         let min_x = max_x;
         let min_y = max_y;
 
-        for (let i = 0; i < bodies.length; ++i) {
-            const body = bodies[i];
-            max_x = body.x > max_x ? body.x : max_x;
-            max_y = body.y > max_y ? body.y : max_y;
-            min_x = body.x < min_x ? body.x : min_x;
-            min_y = body.y < min_y ? body.y : min_y;
+        for (let i = 0; i < n; ++i) {
+            const x = xs[i];
+            const y = ys[i];
+            max_x = x > max_x ? x : max_x;
+            max_y = y > max_y ? y : max_y;
+            min_x = x < min_x ? x : min_x;
+            min_y = y < min_y ? y : min_y;
         }
 
         // Add padding so the bodies aren't right at the edge.
@@ -728,14 +768,32 @@ function nbodyWindow(app_w: number, app_h: number) {
         min_x -= padding;
         min_y -= padding;
 
-        // Render bodies.
-        for (let i = 0; i < bodies.length; ++i) {
-            const body = bodies[i];
-            const x = (body.x - min_x) / (max_x - min_x) * win_x;
-            const y = (body.y - min_y) / (max_y - min_y) * win_y;
+        const scale_x = ww / (max_x - min_x);
+        const scale_y = wh / (max_y - min_y);
+
+        // Render the asteroids through the draw-command buffer, then the Sun
+        // and the planets, which are the first five bodies, on top of them.
+        // Only every step-th asteroid is drawn when there are too many.
+        const asteroidColor = IM_COL32(160, 160, 160, 255);
+        const step = Math.max(1, Math.ceil((n - NBODY_PLANETS) / NBODY_MAX_DRAWN));
+        _set_draw_transform(px, py, 1, 1);
+        for (let i = NBODY_PLANETS; i < n; i += step) {
+            const x = (xs[i] - min_x) * scale_x;
+            const y = (ys[i] - min_y) * scale_y;
+            pushDrawCommand(DRAW_CMD_FILL, 0, asteroidColor, x - 1, y - 1, 2, 2);
+        }
+        flushDrawCommands();
+        for (let i = 0; i < NBODY_PLANETS; ++i) {
+            const x = (xs[i] - min_x) * scale_x;
+            const y = (ys[i] - min_y) * scale_y;
             // Detect the sun and render it specially.
-            const radius = body.name === "Sun" ? 7.0 : 3.0;
-            _ImDrawList_AddCircleFilled(draw_list, addVectors(p, x, y), radius, body.color, 12);
+            const radius = i === 0 ? 7.0 : 3.0;
+            _ImDrawList_AddCircleFilled(draw_list, px + x, py + y, radius, s_nbodyPlanets[i].color, 12);
+        }
+
+        if (NBODY_SIM !== 0) {
+            _igSetCursorScreenPos(px + border_thickness + 4, py + border_thickness + 4);
+            _igTextUnformatted(_nbody_sim_describe(s_nbodySim), c_null);
         }
     }
     _igEnd();
@@ -764,4 +822,10 @@ globalThis.on_event = function on_event(type: number, key_code: number, modifier
     }
 }
 
+// NBODY_BENCH=1 runs the N-body benchmark instead of the demo.
+if (_getenv_int(internAsciiz("NBODY_BENCH"), 0, 0, 1) !== 0) {
+    nbodyBenchmark();
+    _exit(0);
+}
+
 _scroller_run($SHBuiltin.c_native_runtime(), 1024, 768);
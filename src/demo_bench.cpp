@@ -0,0 +1,451 @@
+// Headless benchmark of the game simulation. Runs update_game_state() for a
+// fixed number of ticks with a seeded RNG and scripted input, keeping the
+// requested number of enemies, bullets and explosions alive, and reports the
+// cost per tick.
+//
+// Usage: demo_bench [--ticks=N] [--warmup=N] [--enemies=N] [--bullets=N]
+//                   [--explosions=N] [--seed=N] [--stable]
+//                   [--broadphase=grid|naive] [--collision-sweep]
+//                   [--simd=scalar|sse2|avx2] [--check-simd]
+//                   [--record=FILE] [--replay=FILE]
+//
+// --collision-sweep runs the bullet/enemy collision paths against each other
+// at 1k, 10k and 100k bullets and checks that they end in the same state. The
+// naive path is quadratic, so unless --ticks or --warmup are given it runs only
+// 300 ticks after a warmup of 30.
+//
+// The seed defaults to $GAME_SEED, or 1.
+//
+// --record writes the scripted input to an input log. --replay runs an input
+// log recorded here or by `demo --record` instead of the scripted input, with
+// the seed and length of the log, and checks the final checksum against it.
+// Neither can be combined with --enemies/--bullets/--explosions, whose top-ups
+// don't go through the input.
+//
+// --check-simd runs every SIMD kernel supported by the CPU on random data and
+// checks that the results are bit-for-bit identical to the scalar kernels.
+
+#include "game.h"
+#include "input_log.h"
+#include "sim_kernels.h"
+#include "sokol_app.h"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <vector>
+
+extern "C" const unsigned char img_ship_png[];
+extern "C" const unsigned img_ship_png_size;
+extern "C" const unsigned char img_background_png[];
+extern "C" const unsigned img_background_png_size;
+
+// Count every heap allocation made through operator new, so that we can report
+// allocations per tick.
+static std::atomic<uint64_t> s_allocCount{0};
+
+void *operator new(size_t size) {
+  s_allocCount.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+void *operator new[](size_t size) {
+  return operator new(size);
+}
+void operator delete(void *p) noexcept {
+  free(p);
+}
+void operator delete[](void *p) noexcept {
+  free(p);
+}
+void operator delete(void *p, size_t) noexcept {
+  free(p);
+}
+void operator delete[](void *p, size_t) noexcept {
+  free(p);
+}
+
+struct BenchOptions {
+  long ticks = 10000;
+  long warmup = 600;
+  long enemies = 0;
+  long bullets = 0;
+  long explosions = 0;
+  uint64_t seed = game_default_seed();
+  bool stable = false;
+  bool grid = true;
+  bool collisionSweep = false;
+  /// Whether --ticks and --warmup were given, rather than left at the
+  /// defaults that don't suit --collision-sweep.
+  bool ticksGiven = false;
+  bool warmupGiven = false;
+  bool checkSimd = false;
+  const char *record = nullptr;
+  const char *replay = nullptr;
+};
+
+struct BenchResult {
+  double nsPerTick;
+  uint64_t p50, p99;
+  double allocsPerTick;
+  uint64_t checksum;
+};
+
+static bool parseLong(const char *arg, const char *name, long *out) {
+  size_t len = strlen(name);
+  if (strncmp(arg, name, len) != 0 || arg[len] != '=')
+    return false;
+  *out = strtol(arg + len + 1, nullptr, 0);
+  return true;
+}
+
+static void usage() {
+  fprintf(
+      stderr,
+      "usage: demo_bench [--ticks=N] [--warmup=N] [--enemies=N] [--bullets=N] "
+      "[--explosions=N] [--seed=N] [--stable] [--broadphase=grid|naive] "
+      "[--collision-sweep] [--simd=scalar|sse2|avx2] [--check-simd] [--record=FILE] "
+      "[--replay=FILE]\n");
+  exit(1);
+}
+
+static BenchOptions parseOptions(int argc, char **argv) {
+  BenchOptions opt;
+  for (int i = 1; i < argc; ++i) {
+    if (parseLong(argv[i], "--ticks", &opt.ticks)) {
+      opt.ticksGiven = true;
+      continue;
+    }
+    if (parseLong(argv[i], "--warmup", &opt.warmup)) {
+      opt.warmupGiven = true;
+      continue;
+    }
+    if (parseLong(argv[i], "--enemies", &opt.enemies) ||
+        parseLong(argv[i], "--bullets", &opt.bullets) ||
+        parseLong(argv[i], "--explosions", &opt.explosions)) {
+      continue;
+    }
+    if (strncmp(argv[i], "--seed=", 7) == 0) {
+      opt.seed = strtoull(argv[i] + 7, nullptr, 0);
+      continue;
+    }
+    if (strcmp(argv[i], "--stable") == 0) {
+      opt.stable = true;
+      continue;
+    }
+    if (strcmp(argv[i], "--broadphase=grid") == 0 || strcmp(argv[i], "--broadphase=naive") == 0) {
+      opt.grid = strcmp(argv[i], "--broadphase=grid") == 0;
+      continue;
+    }
+    if (strcmp(argv[i], "--collision-sweep") == 0) {
+      opt.collisionSweep = true;
+      continue;
+    }
+    if (strncmp(argv[i], "--simd=", 7) == 0) {
+      bool found = false;
+      for (SimdLevel level : {SimdLevel::Scalar, SimdLevel::SSE2, SimdLevel::AVX2}) {
+        if (strcmp(argv[i] + 7, simd_level_name(level)) == 0) {
+          simd_set_level(level);
+          found = true;
+        }
+      }
+      if (found)
+        continue;
+    }
+    if (strcmp(argv[i], "--check-simd") == 0) {
+      opt.checkSimd = true;
+      continue;
+    }
+    if (strncmp(argv[i], "--record=", 9) == 0) {
+      opt.record = argv[i] + 9;
+      continue;
+    }
+    if (strncmp(argv[i], "--replay=", 9) == 0) {
+      opt.replay = argv[i] + 9;
+      continue;
+    }
+    usage();
+  }
+  if (opt.ticks <= 0 || opt.warmup < 0 || opt.enemies < 0 || opt.bullets < 0 ||
+      opt.explosions < 0) {
+    usage();
+  }
+  if ((opt.record || opt.replay) && (opt.enemies || opt.bullets || opt.explosions))
+    usage();
+  return opt;
+}
+
+static void pngSize(const unsigned char *data, unsigned size, int *w, int *h) {
+  int n;
+  if (!stbi_info_from_memory(data, (int)size, w, h, &n))
+    abort();
+}
+
+/// Deterministic stand-in for the keyboard: the ship sweeps up and down and
+/// fires a bullet every few ticks. Key changes go through game_key(), like
+/// real input, and are recorded if \p recorder is open.
+static void scriptedInput(long tick, InputRecorder &recorder) {
+  long phase = tick % 240;
+  auto setKey = [tick, &recorder](int keyCode, bool down) {
+    if (s_keys[keyCode] == down)
+      return;
+    recorder.key((uint32_t)tick, keyCode, down);
+    game_key(keyCode, down);
+  };
+  setKey(SAPP_KEYCODE_UP, phase < 60);
+  setKey(SAPP_KEYCODE_DOWN, phase >= 120 && phase < 180);
+  setKey(SAPP_KEYCODE_LEFT, phase >= 60 && phase < 90);
+  setKey(SAPP_KEYCODE_RIGHT, phase >= 180 && phase < 210);
+  setKey(SAPP_KEYCODE_SPACE, tick % 8 == 0);
+}
+
+/// Keep the requested population alive. Entities are placed all over the
+/// playfield so that collisions keep happening.
+static void topUp(const BenchOptions &opt) {
+  while ((long)s_enemies.size() < opt.enemies)
+    createEnemy(mathRandom(ASSUMED_W), mathRandom(ASSUMED_H - 64));
+  while ((long)s_bullets.size() < opt.bullets)
+    createBullet(mathRandom(ASSUMED_W), mathRandom(ASSUMED_H));
+  // Explosions are not tracked individually; keep the particle count of the
+  // requested number of fresh explosions alive instead.
+  while ((long)s_particles.size() < opt.explosions * 50 &&
+         s_particles.size() < s_particles.capacity()) {
+    createExplosion(mathRandom(ASSUMED_W), mathRandom(ASSUMED_H));
+  }
+}
+
+static int s_shipW, s_shipH, s_bkgW;
+
+/// Run the simulation from a fresh state with the given options. If \p replay
+/// is given, its input, seed and length replace the scripted input and the
+/// options.
+static BenchResult runBench(const BenchOptions &opt, InputReplay *replay = nullptr) {
+  long warmup = replay ? 0 : opt.warmup;
+  long ticks = replay ? (long)replay->endTick() : opt.ticks;
+
+  s_gameOptions.stableOrder = opt.stable;
+  s_gameOptions.gridBroadphase = opt.grid;
+  game_seed(replay ? replay->seed() : opt.seed);
+  game_init(s_shipW, s_shipH, s_bkgW, GameHooks{});
+
+  InputRecorder recorder;
+  if (opt.record && !recorder.open(opt.record, opt.seed))
+    exit(1);
+
+  std::vector<uint64_t> samples;
+  samples.reserve(ticks);
+  uint64_t allocs = 0;
+  uint64_t totalNs = 0;
+
+  for (long tick = 0; tick < warmup + ticks; ++tick) {
+    if (replay) {
+      replay->apply((uint32_t)tick);
+    } else {
+      scriptedInput(tick, recorder);
+      topUp(opt);
+    }
+
+    uint64_t allocsBefore = s_allocCount.load(std::memory_order_relaxed);
+    auto start = std::chrono::steady_clock::now();
+    update_game_state(true);
+    auto end = std::chrono::steady_clock::now();
+    uint64_t allocsAfter = s_allocCount.load(std::memory_order_relaxed);
+
+    if (tick < warmup)
+      continue;
+    uint64_t ns = std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
+    samples.push_back(ns);
+    totalNs += ns;
+    allocs += allocsAfter - allocsBefore;
+  }
+
+  std::sort(samples.begin(), samples.end());
+  auto percentile = [&samples](double p) -> uint64_t {
+    if (samples.empty())
+      return 0;
+    return samples[std::min(samples.size() - 1, (size_t)(p * samples.size()))];
+  };
+
+  BenchResult res;
+  res.nsPerTick = (double)totalNs / ticks;
+  res.p50 = percentile(0.50);
+  res.p99 = percentile(0.99);
+  res.allocsPerTick = (double)allocs / ticks;
+  res.checksum = game_checksum();
+  if (recorder.isOpen())
+    recorder.finish(game_tick(), res.checksum);
+  return res;
+}
+
+/// Compare the naive and grid collision paths at increasing bullet counts.
+static int collisionSweep(BenchOptions opt) {
+  if (!opt.enemies)
+    opt.enemies = 100;
+  if (!opt.ticksGiven)
+    opt.ticks = 300;
+  if (!opt.warmupGiven)
+    opt.warmup = 30;
+  printf(
+      "collision sweep: ticks=%ld warmup=%ld enemies=%ld seed=%llu order=%s\n",
+      opt.ticks,
+      opt.warmup,
+      opt.enemies,
+      (unsigned long long)opt.seed,
+      opt.stable ? "stable" : "unordered");
+  printf("%8s %14s %14s %8s  %s\n", "bullets", "naive ns/tick", "grid ns/tick", "speedup", "state");
+
+  int status = 0;
+  for (long bullets : {1000L, 10000L, 100000L}) {
+    opt.bullets = bullets;
+    opt.grid = false;
+    BenchResult naive = runBench(opt);
+    opt.grid = true;
+    BenchResult grid = runBench(opt);
+
+    bool same = naive.checksum == grid.checksum;
+    if (!same)
+      status = 1;
+    printf(
+        "%8ld %14.1f %14.1f %7.1fx  %s\n",
+        bullets,
+        naive.nsPerTick,
+        grid.nsPerTick,
+        naive.nsPerTick / grid.nsPerTick,
+        same ? "same" : "MISMATCH");
+  }
+  return status;
+}
+
+/// Run every kernel at every supported SIMD level over the same random input
+/// and compare the outputs with the scalar ones bit-for-bit. The length is not
+/// a multiple of the vector width and the arrays are offset by one element, so
+/// the unaligned loads and the scalar tails are exercised too.
+static int checkSimd(uint64_t seed) {
+  const size_t n = 1003;
+  game_seed(seed);
+  auto randomColumn = [n](double lo, double hi) {
+    std::vector<float> v(n + 1);
+    for (float &f : v)
+      f = (float)(lo + mathRandom(hi - lo));
+    return v;
+  };
+  const std::vector<float> x = randomColumn(-100, 900), y = randomColumn(-100, 700);
+  const std::vector<float> velX = randomColumn(-20, 20), velY = randomColumn(-20, 20);
+  const std::vector<float> life = randomColumn(0, 40), maxLife = randomColumn(25, 40);
+
+  struct Output {
+    std::vector<float> x, y, oldX, oldY, life, alpha, curX, curY;
+  };
+  auto run = [&](SimdLevel level) {
+    simd_set_level(level);
+    Output o;
+    o.x = x;
+    o.y = y;
+    o.oldX.resize(n + 1);
+    o.oldY.resize(n + 1);
+    o.life = life;
+    o.alpha.resize(n + 1);
+    o.curX.resize(n + 1);
+    o.curY.resize(n + 1);
+    kernel_integrate(
+        &o.x[1], &o.y[1], &o.oldX[1], &o.oldY[1], &velX[1], &velY[1], n, true);
+    kernel_integrate(
+        &o.x[1], &o.y[1], &o.oldX[1], &o.oldY[1], &velX[1], &velY[1], n, false);
+    kernel_age(&o.life[1], &maxLife[1], &o.alpha[1], n);
+    kernel_interpolate(
+        &o.x[1], &o.y[1], &o.oldX[1], &o.oldY[1], 0.37f, &o.curX[1], &o.curY[1], n);
+    return o;
+  };
+  auto same = [](const std::vector<float> &a, const std::vector<float> &b) {
+    return memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0;
+  };
+
+  SimdLevel best = simd_detect();
+  Output ref = run(SimdLevel::Scalar);
+  int status = 0;
+  for (SimdLevel level : {SimdLevel::SSE2, SimdLevel::AVX2}) {
+    if ((int)level > (int)best) {
+      printf("%-6s not supported\n", simd_level_name(level));
+      continue;
+    }
+    Output o = run(level);
+    bool ok = same(o.x, ref.x) && same(o.y, ref.y) && same(o.oldX, ref.oldX) &&
+        same(o.oldY, ref.oldY) && same(o.life, ref.life) && same(o.alpha, ref.alpha) &&
+        same(o.curX, ref.curX) && same(o.curY, ref.curY);
+    if (!ok)
+      status = 1;
+    printf("%-6s %s\n", simd_level_name(level), ok ? "identical to scalar" : "MISMATCH");
+  }
+  simd_set_level(best);
+  return status;
+}
+
+int main(int argc, char **argv) {
+  BenchOptions opt = parseOptions(argc, argv);
+
+  int bkgH;
+  pngSize(img_ship_png, img_ship_png_size, &s_shipW, &s_shipH);
+  pngSize(img_background_png, img_background_png_size, &s_bkgW, &bkgH);
+
+  if (opt.checkSimd)
+    return checkSimd(opt.seed);
+  if (opt.collisionSweep)
+    return collisionSweep(opt);
+
+  if (opt.replay) {
+    InputReplay replay;
+    if (!replay.load(opt.replay))
+      return 1;
+    if (!replay.endTick()) {
+      fprintf(stderr, "%s: the log is empty\n", opt.replay);
+      return 1;
+    }
+    BenchResult res = runBench(opt, &replay);
+    bool same = res.checksum == replay.checksum();
+    printf(
+        "replay=%s ticks=%u seed=%llu order=%s broadphase=%s simd=%s\n",
+        opt.replay,
+        replay.endTick(),
+        (unsigned long long)replay.seed(),
+        opt.stable ? "stable" : "unordered",
+        opt.grid ? "grid" : "naive",
+        simd_level_name(simd_level()));
+    printf(
+        "ns/tick: %.1f  p50: %llu  p99: %llu\n",
+        res.nsPerTick,
+        (unsigned long long)res.p50,
+        (unsigned long long)res.p99);
+    printf(
+        "checksum: %016llx (%s)\n",
+        (unsigned long long)res.checksum,
+        same ? "matches the recording" : "MISMATCH");
+    return same ? 0 : 1;
+  }
+
+  BenchResult res = runBench(opt);
+  printf(
+      "ticks=%ld enemies=%ld bullets=%ld explosions=%ld seed=%llu order=%s broadphase=%s "
+      "simd=%s\n",
+      opt.ticks,
+      opt.enemies,
+      opt.bullets,
+      opt.explosions,
+      (unsigned long long)opt.seed,
+      opt.stable ? "stable" : "unordered",
+      opt.grid ? "grid" : "naive",
+      simd_level_name(simd_level()));
+  printf(
+      "ns/tick: %.1f  p50: %llu  p99: %llu\n",
+      res.nsPerTick,
+      (unsigned long long)res.p50,
+      (unsigned long long)res.p99);
+  printf("allocs/tick: %.3f\n", res.allocsPerTick);
+  printf("checksum: %016llx\n", (unsigned long long)res.checksum);
+  return 0;
+}
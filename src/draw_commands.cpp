@@ -0,0 +1,54 @@
+#include "draw_commands.h"
+
+#include "sokol_app.h"
+#include "sokol_gfx.h"
+#include "sprite_batch.h"
+// Must be separate to avoid reordering.
+#include "sokol_imgui.h"
+
+#include <cstddef>
+
+// demo.js writes the records through Int32Array and Float32Array views, at
+// word index DRAW_CMD_WORDS * record + DRAW_CMD_<field>, so every field must be
+// at 4 * its DRAW_CMD_* index.
+static_assert(sizeof(DrawCommand) == 32, "DrawCommand layout is shared with demo.js");
+static_assert(offsetof(DrawCommand, texture) == 4, "DrawCommand layout is shared with demo.js");
+static_assert(offsetof(DrawCommand, color) == 8, "DrawCommand layout is shared with demo.js");
+static_assert(offsetof(DrawCommand, x) == 12, "DrawCommand layout is shared with demo.js");
+static_assert(offsetof(DrawCommand, y) == 16, "DrawCommand layout is shared with demo.js");
+static_assert(offsetof(DrawCommand, w) == 20, "DrawCommand layout is shared with demo.js");
+static_assert(offsetof(DrawCommand, h) == 24, "DrawCommand layout is shared with demo.js");
+
+static SpriteBatch s_batch;
+
+extern "C" void set_draw_transform(float org_x, float org_y, float scale_x, float scale_y) {
+  s_batch.setTransform(ImVec2{org_x, org_y}, ImVec2{scale_x, scale_y});
+}
+
+extern "C" void flush_draw_commands(const DrawCommand *cmds, int count) {
+  if (count <= 0)
+    return;
+  ImDrawList *dl = igGetWindowDrawList();
+
+  for (int start = 0; start < count;) {
+    // Find the run of commands that can share one draw command.
+    const DrawCommand &first = cmds[start];
+    bool solid = first.op != DRAW_CMD_BLIT;
+    int end = start + 1;
+    while (end < count && (cmds[end].op != DRAW_CMD_BLIT) == solid &&
+           (solid || cmds[end].texture == first.texture)) {
+      ++end;
+    }
+
+    if (solid)
+      s_batch.beginSolid(dl, end - start);
+    else
+      s_batch.begin(dl, simgui_imtextureid(simgui_image_t{first.texture}), end - start);
+    for (int i = start; i != end; ++i) {
+      const DrawCommand &cmd = cmds[i];
+      s_batch.rect(cmd.x, cmd.y, cmd.w, cmd.h, cmd.color);
+    }
+    s_batch.end();
+    start = end;
+  }
+}
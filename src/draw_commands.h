@@ -0,0 +1,51 @@
+#pragma once
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A command buffer for the rectangles that the JS game draws every frame.
+//
+// Instead of one ImDrawList call (and the ImVec2 arguments it needs) per
+// rectangle, JS appends fixed-size DrawCommand records to a buffer in native
+// memory and hands the whole buffer to flush_draw_commands(), which expands
+// it into the current window's draw list with SpriteBatch.
+//
+// Positions are in game units and are mapped to screen pixels by the
+// transform set with set_draw_transform().
+
+enum {
+  /// Solid rectangle of color `color`. `texture` is ignored.
+  DRAW_CMD_FILL = 0,
+  /// Rectangle showing the whole of the simgui_image_t with id `texture`,
+  /// modulated by `color`.
+  DRAW_CMD_BLIT = 1,
+};
+
+/// One record of the buffer, DRAW_CMD_WORDS 32-bit words. demo.js maps the
+/// buffer with an Int32Array and a Float32Array and writes the fields at the
+/// DRAW_CMD_* word indices it declares, so the layout must not change without
+/// updating them.
+typedef struct DrawCommand {
+  uint32_t op;
+  uint32_t texture;
+  /// ImU32 color, as made by IM_COL32().
+  uint32_t color;
+  float x, y, w, h;
+  uint32_t reserved;
+} DrawCommand;
+
+/// Map game position (x, y) to screen position (org + x * scale) in the
+/// following flushes.
+void set_draw_transform(float org_x, float org_y, float scale_x, float scale_y);
+
+/// Add the first \p count commands of \p cmds to the draw list of the current
+/// ImGui window. Consecutive commands with the same op and texture become one
+/// draw command.
+void flush_draw_commands(const DrawCommand *cmds, int count);
+
+#ifdef __cplusplus
+}
+#endif
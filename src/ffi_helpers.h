@@ -1,6 +1,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 
 static inline char _sh_ptr_read_c_char(char *ptr, int offset) {
   return *(char *)(ptr + offset);
@@ -95,3 +96,6 @@ static inline void _sh_ptr_write_c_ptr(char *ptr, int offset, char *v) {
 static inline char *_sh_ptr_add(char *ptr, int offset) {
   return ptr + offset;
 }
+static inline double _sh_ptr_to_double(char *ptr) {
+  return (double)(uintptr_t)ptr;
+}
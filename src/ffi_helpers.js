@@ -29,6 +29,7 @@ const _sh_ptr_write_c_double = $SHBuiltin.extern_c({include: "ffi_helpers.h"}, f
 const _sh_ptr_read_c_ptr = $SHBuiltin.extern_c({include: "ffi_helpers.h"}, function _sh_ptr_read_c_ptr(ptr: c_ptr, offset: c_int): c_ptr { throw 0; });
 const _sh_ptr_write_c_ptr = $SHBuiltin.extern_c({include: "ffi_helpers.h"}, function _sh_ptr_write_c_ptr(ptr: c_ptr, offset: c_int, v: c_ptr): void {include: "ffi_helpers.h"});
 const _sh_ptr_add = $SHBuiltin.extern_c({include: "ffi_helpers.h"}, function _sh_ptr_add(ptr: c_ptr, offset: c_int): c_ptr { throw 0; });
+const _sh_ptr_to_double = $SHBuiltin.extern_c({include: "ffi_helpers.h"}, function _sh_ptr_to_double(ptr: c_ptr): c_double { throw 0; });
 
 const _malloc = $SHBuiltin.extern_c({include: "stdlib.h"}, function malloc(size: c_size_t): c_ptr {
     throw 0;
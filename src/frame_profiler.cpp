@@ -0,0 +1,152 @@
+#include "frame_profiler.h"
+
+#include "sokol_gfx.h"
+// Must be separate to avoid reordering.
+#include "sokol_debugtext.h"
+
+#include <algorithm>
+#include <cstdio>
+
+FrameProfiler::FrameProfiler(std::vector<const char *> names)
+    : names_(std::move(names)),
+      starts_(names_.size()),
+      current_(names_.size()),
+      history_((names_.size() + 2) * HISTORY),
+      shown_(names_.size() + 2) {}
+
+void FrameProfiler::beginFrame() {
+  lastFrameStart_ = frameStart_;
+  frameStart_ = stm_now();
+  std::fill(current_.begin(), current_.end(), 0);
+}
+
+void FrameProfiler::endFrame() {
+  uint64_t now = stm_now();
+  if (tracing_ && spans_.size() < MAX_SPANS)
+    spans_.push_back(Span{frameStage(), 1, frameStart_, now});
+
+  size_t n = names_.size();
+  for (size_t i = 0; i != n; ++i)
+    history_[i * HISTORY + historyPos_] = (float)stm_ms(current_[i]);
+  history_[n * HISTORY + historyPos_] = (float)stm_ms(stm_diff(now, frameStart_));
+  history_[(n + 1) * HISTORY + historyPos_] =
+      lastFrameStart_ ? (float)stm_ms(stm_diff(frameStart_, lastFrameStart_)) : 0;
+
+  historyPos_ = (historyPos_ + 1) % HISTORY;
+  historySize_ = std::min(historySize_ + 1, HISTORY);
+}
+
+void FrameProfiler::record(unsigned stage, uint64_t start, uint64_t end) {
+  current_[stage] += stm_diff(end, start);
+  if (tracing_ && spans_.size() < MAX_SPANS)
+    spans_.push_back(Span{stage, 1, start, end});
+}
+
+void FrameProfiler::recordThread(
+    unsigned stage,
+    const char *thread,
+    uint64_t start,
+    uint64_t end,
+    uint64_t time) {
+  current_[stage] += time;
+  if (!tracing_ || spans_.size() >= MAX_SPANS)
+    return;
+  size_t index = std::find(threads_.begin(), threads_.end(), thread) - threads_.begin();
+  if (index == threads_.size())
+    threads_.push_back(thread);
+  spans_.push_back(Span{stage, (uint32_t)index + 2, start, end});
+}
+
+FrameProfiler::Summary FrameProfiler::summarize(unsigned row) const {
+  if (!historySize_)
+    return Summary{0, 0, 0};
+  float sorted[HISTORY];
+  const float *samples = &history_[row * HISTORY];
+  std::copy(samples, samples + historySize_, sorted);
+  std::sort(sorted, sorted + historySize_);
+
+  double sum = 0;
+  for (unsigned i = 0; i != historySize_; ++i)
+    sum += sorted[i];
+  unsigned p99 = std::min(historySize_ - 1, (unsigned)(0.99 * historySize_));
+  return Summary{sorted[0], sum / historySize_, sorted[p99]};
+}
+
+void FrameProfiler::printOverlay() {
+  if (++sinceRefresh_ >= REFRESH) {
+    sinceRefresh_ = 0;
+    for (unsigned row = 0; row != shown_.size(); ++row)
+      shown_[row] = summarize(row);
+  }
+  const Summary &interval = shown_.back();
+
+  sdtx_printf(
+      "FPS: %d%s\n",
+      interval.avgMs > 0 ? (int)(1000.0 / interval.avgMs + 0.5) : 0,
+      tracing_ ? "  [tracing]" : "");
+  sdtx_printf("%-10s %6s %6s %6s ms\n", "", "min", "avg", "p99");
+  for (unsigned row = 0; row != shown_.size(); ++row) {
+    const char *name = row < names_.size() ? names_[row]
+        : row == names_.size()             ? "frame"
+                                           : "interval";
+    const Summary &s = shown_[row];
+    sdtx_printf("%-10s %6.2f %6.2f %6.2f\n", name, s.minMs, s.avgMs, s.p99Ms);
+  }
+}
+
+void FrameProfiler::startTrace(const char *path) {
+  tracePath_ = path;
+  spans_.clear();
+  tracing_ = true;
+}
+
+bool FrameProfiler::stopTrace() {
+  tracing_ = false;
+  FILE *f = fopen(tracePath_.c_str(), "w");
+  if (!f) {
+    perror(tracePath_.c_str());
+    return false;
+  }
+  // Complete ("X") events, timestamps in microseconds.
+  fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+  fprintf(
+      f,
+      "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":1,"
+      "\"args\":{\"name\":\"main\"}}");
+  for (size_t i = 0; i != threads_.size(); ++i) {
+    fprintf(
+        f,
+        ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,"
+        "\"args\":{\"name\":\"%s\"}}",
+        i + 2,
+        threads_[i]);
+  }
+  for (const Span &span : spans_) {
+    const char *name = span.stage < names_.size() ? names_[span.stage] : "frame";
+    fprintf(
+        f,
+        ",\n{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%u,"
+        "\"ts\":%.3f,\"dur\":%.3f}",
+        name,
+        span.stage < names_.size() ? "stage" : "frame",
+        span.tid,
+        stm_us(span.start),
+        stm_us(stm_diff(span.end, span.start)));
+  }
+  fprintf(f, "\n]}\n");
+  bool ok = !ferror(f);
+  if (fclose(f) != 0)
+    ok = false;
+  if (!ok) {
+    perror(tracePath_.c_str());
+    return false;
+  }
+  printf(
+      "frame trace: %zu spans written to %s%s\n",
+      spans_.size(),
+      tracePath_.c_str(),
+      spans_.size() >= MAX_SPANS ? " (truncated)" : "");
+  spans_.clear();
+  spans_.shrink_to_fit();
+  return true;
+}
@@ -0,0 +1,127 @@
+#pragma once
+
+#include "sokol_time.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/// CPU timing of the stages of the frame loop.
+///
+/// The time of every stage is summed over a frame, since some stages (like
+/// simulation ticks) can run several times per frame, and kept for the last
+/// HISTORY frames. printOverlay() shows min, average and 99th percentile of
+/// each stage over that window, so a spike in one stage stands out.
+///
+/// While a trace is being captured, every individual span is also recorded
+/// and written by stopTrace() in the Chrome trace event format, which can be
+/// loaded into chrome://tracing or Perfetto.
+class FrameProfiler {
+ public:
+  static constexpr unsigned HISTORY = 256;
+
+  /// \p names are the stage names, indexed by stage number. They must be
+  /// string literals or otherwise outlive the profiler.
+  explicit FrameProfiler(std::vector<const char *> names);
+
+  /// Start a frame.
+  void beginFrame();
+  /// Finish the frame started by beginFrame() and add it to the history.
+  void endFrame();
+
+  void begin(unsigned stage) {
+    starts_[stage] = stm_now();
+  }
+  void end(unsigned stage) {
+    record(stage, starts_[stage], stm_now());
+  }
+  /// Add \p time to \p stage for work done on another thread, named
+  /// \p thread (which must outlive the profiler). The trace shows it on that
+  /// thread as a span from \p start to \p end.
+  void recordThread(
+      unsigned stage,
+      const char *thread,
+      uint64_t start,
+      uint64_t end,
+      uint64_t time);
+
+  /// Print FPS, from the measured interval between frame starts, and the
+  /// per-stage table with sokol_debugtext, starting at the current cursor
+  /// position. The numbers are refreshed every REFRESH frames so that they
+  /// can be read.
+  void printOverlay();
+
+  /// Start recording spans, to be written to \p path by stopTrace().
+  void startTrace(const char *path);
+  bool tracing() const {
+    return tracing_;
+  }
+  /// Stop recording and write the trace. Returns false if the file couldn't
+  /// be written.
+  bool stopTrace();
+
+ private:
+  static constexpr unsigned REFRESH = 30;
+  /// Bound on the memory used by a trace: about a minute at 60 FPS with a
+  /// few dozen spans per frame.
+  static constexpr size_t MAX_SPANS = 1 << 20;
+
+  struct Summary {
+    double minMs, avgMs, p99Ms;
+  };
+  struct Span {
+    /// Stage index, or frameStage() for the whole frame.
+    uint32_t stage;
+    /// Trace thread id: 1 for the frame loop, then 2 + index in threads_.
+    uint32_t tid;
+    uint64_t start, end;
+  };
+  uint32_t frameStage() const {
+    return (uint32_t)names_.size();
+  }
+
+  std::vector<const char *> names_;
+  /// Start of the current span of every stage.
+  std::vector<uint64_t> starts_;
+  /// Time spent in every stage in the current frame.
+  std::vector<uint64_t> current_;
+  /// Per-frame totals: HISTORY entries for each stage, then for the whole
+  /// frame, then for the interval between frames.
+  std::vector<float> history_;
+  unsigned historyPos_ = 0;
+  unsigned historySize_ = 0;
+  uint64_t frameStart_ = 0;
+  uint64_t lastFrameStart_ = 0;
+
+  /// Cached printOverlay() numbers, one per stage plus frame and interval.
+  std::vector<Summary> shown_;
+  unsigned sinceRefresh_ = REFRESH;
+
+  bool tracing_ = false;
+  std::string tracePath_;
+  std::vector<Span> spans_;
+  /// Names of the other threads passed to recordThread().
+  std::vector<const char *> threads_;
+
+  void record(unsigned stage, uint64_t start, uint64_t end);
+  /// Summary of history row \p row.
+  Summary summarize(unsigned row) const;
+};
+
+/// Time the enclosing scope as a stage of \p profiler.
+class ScopedStage {
+ public:
+  ScopedStage(FrameProfiler &profiler, unsigned stage) : profiler_(profiler), stage_(stage) {
+    profiler_.begin(stage_);
+  }
+  ~ScopedStage() {
+    profiler_.end(stage_);
+  }
+  ScopedStage(const ScopedStage &) = delete;
+  ScopedStage &operator=(const ScopedStage &) = delete;
+
+ private:
+  FrameProfiler &profiler_;
+  unsigned stage_;
+};
@@ -0,0 +1,540 @@
+#include "game.h"
+#include "rng.h"
+#include "sim_kernels.h"
+#include "spatial_grid.h"
+#include "spsc_queue.h"
+
+#include "sokol_app.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+static_assert(GAME_MAX_KEYCODES == SAPP_MAX_KEYCODES, "s_keys must be indexable by sapp_keycode");
+
+static Rng s_rng;
+
+double mathRandom(double range) {
+  return s_rng.nextFloat() * range;
+}
+
+void game_seed(uint64_t seed) {
+  s_rng.seed(seed);
+}
+
+uint64_t game_default_seed() {
+  const char *env = getenv("GAME_SEED");
+  return env ? strtoull(env, nullptr, 0) : 1;
+}
+
+GameOptions s_gameOptions;
+
+bool s_keys[GAME_MAX_KEYCODES];
+
+std::unique_ptr<Ship> s_ship;
+EntityColumns s_bullets;
+EntityColumns s_enemies;
+ParticlePool s_particles;
+
+float s_oldBackgroundX = 0;
+float s_backgroundX = 0;
+static float s_backgroundSpeed = 2;
+static float s_backgroundW = 0;
+
+static int s_enemySpawnCounter = 0;
+static uint32_t s_tick = 0;
+static const int s_enemySpawnRate = 120;
+
+static GameHooks s_hooks;
+/// Events from game_post_key(), drained by update_game_state().
+static SpscQueue<InputEvent, 256> s_input;
+/// Space presses since the last tick.
+static unsigned s_pendingShots = 0;
+
+/// Broadphase for the bullet/enemy collisions. Enemies are 64x64, so with 32
+/// pixel cells a query touches at most 3x3 cells.
+static SpatialGrid s_bulletGrid(ASSUMED_W, ASSUMED_H, 32);
+/// Bullets that hit an enemy this tick. They are removed after all enemies
+/// have been tested, so that indices stay valid during the collision pass.
+static std::vector<uint8_t> s_bulletHit;
+/// Scratch buffer for grid queries.
+static std::vector<uint32_t> s_candidates;
+
+void Ship::update(bool save) {
+  if (s_keys[SAPP_KEYCODE_LEFT])
+    velX = -speed;
+  else if (s_keys[SAPP_KEYCODE_RIGHT])
+    velX = speed;
+  else
+    velX = 0;
+  if (s_keys[SAPP_KEYCODE_UP])
+    velY = -speed;
+  else if (s_keys[SAPP_KEYCODE_DOWN])
+    velY = speed;
+  else
+    velY = 0;
+  Actor::update(save);
+}
+
+void EntityColumns::reserve(size_t n) {
+  x.reserve(n);
+  y.reserve(n);
+  oldX.reserve(n);
+  oldY.reserve(n);
+  velX.reserve(n);
+  velY.reserve(n);
+  width.reserve(n);
+  height.reserve(n);
+}
+
+void EntityColumns::push(float x, float y, float width, float height, float velX, float velY) {
+  this->x.push_back(x);
+  this->y.push_back(y);
+  this->oldX.push_back(x);
+  this->oldY.push_back(y);
+  this->velX.push_back(velX);
+  this->velY.push_back(velY);
+  this->width.push_back(width);
+  this->height.push_back(height);
+}
+
+void EntityColumns::removeAt(size_t i) {
+  x.erase(x.begin() + i);
+  y.erase(y.begin() + i);
+  oldX.erase(oldX.begin() + i);
+  oldY.erase(oldY.begin() + i);
+  velX.erase(velX.begin() + i);
+  velY.erase(velY.begin() + i);
+  width.erase(width.begin() + i);
+  height.erase(height.begin() + i);
+}
+
+void EntityColumns::swapRemove(size_t i) {
+  size_t last = size() - 1;
+  if (i != last)
+    copyEntity(last, i);
+  resize(last);
+}
+
+void EntityColumns::removeMarked(std::vector<uint8_t> &marks) {
+  size_t n = size();
+  if (s_gameOptions.stableOrder) {
+    size_t alive = 0;
+    for (size_t i = 0; i < n; ++i) {
+      if (!marks[i]) {
+        if (alive != i)
+          copyEntity(i, alive);
+        ++alive;
+      }
+    }
+    n = alive;
+  } else {
+    for (size_t i = 0; i < n;) {
+      if (marks[i]) {
+        if (i != --n) {
+          copyEntity(n, i);
+          marks[i] = marks[n];
+        }
+        continue;
+      }
+      ++i;
+    }
+  }
+  resize(n);
+  marks.assign(n, 0);
+}
+
+void EntityColumns::clear() {
+  x.clear();
+  y.clear();
+  oldX.clear();
+  oldY.clear();
+  velX.clear();
+  velY.clear();
+  width.clear();
+  height.clear();
+}
+
+void EntityColumns::copyEntity(size_t from, size_t to) {
+  x[to] = x[from];
+  y[to] = y[from];
+  oldX[to] = oldX[from];
+  oldY[to] = oldY[from];
+  velX[to] = velX[from];
+  velY[to] = velY[from];
+  width[to] = width[from];
+  height[to] = height[from];
+}
+
+void EntityColumns::resize(size_t n) {
+  x.resize(n);
+  y.resize(n);
+  oldX.resize(n);
+  oldY.resize(n);
+  velX.resize(n);
+  velY.resize(n);
+  width.resize(n);
+  height.resize(n);
+}
+
+void EntityColumns::integrate(bool save) {
+  kernel_integrate(
+      x.data(), y.data(), oldX.data(), oldY.data(), velX.data(), velY.data(), size(), save);
+}
+
+void EntityColumns::interpolate(float dt, float *outX, float *outY) const {
+  kernel_interpolate(x.data(), y.data(), oldX.data(), oldY.data(), dt, outX, outY, size());
+}
+
+void EntityColumns::interpolate(size_t begin, size_t end, float dt, float *outX, float *outY)
+    const {
+  kernel_interpolate(
+      x.data() + begin,
+      y.data() + begin,
+      oldX.data() + begin,
+      oldY.data() + begin,
+      dt,
+      outX,
+      outY,
+      end - begin);
+}
+
+void ParticlePool::init(size_t capacity) {
+  clear();
+  capacity_ = capacity;
+  reserve(capacity);
+  life.reserve(capacity);
+  maxLife.reserve(capacity);
+  alpha.reserve(capacity);
+}
+
+size_t ParticlePool::spawnBurst(float x, float y, size_t count) {
+  size_t first = size();
+  count = std::min(count, capacity_ - first);
+  resize(first + count);
+
+  // Each particle takes four random numbers: velX, velY, maxLife and size.
+  // Draw them in chunks with a single fill() call each.
+  static const size_t CHUNK = 64;
+  float r[CHUNK * 4];
+  for (size_t i = first, e = first + count; i < e;) {
+    size_t k = std::min(CHUNK, e - i);
+    s_rng.fill(r, k * 4);
+    for (const float *ri = r; k; --k, ++i, ri += 4) {
+      this->x[i] = this->oldX[i] = x;
+      this->y[i] = this->oldY[i] = y;
+      velX[i] = (ri[0] * 4.0 - 2) * 2;
+      velY[i] = (ri[1] * 4.0 - 2) * 2;
+      maxLife[i] = (ri[2] * 30.0 + 50) / 2;
+      width[i] = height[i] = ri[3] * 2.0 + 1;
+      life[i] = 0;
+      alpha[i] = 1;
+    }
+  }
+  return count;
+}
+
+void ParticlePool::removeAt(size_t i) {
+  EntityColumns::removeAt(i);
+  life.erase(life.begin() + i);
+  maxLife.erase(maxLife.begin() + i);
+  alpha.erase(alpha.begin() + i);
+}
+
+void ParticlePool::swapRemove(size_t i) {
+  size_t last = size() - 1;
+  if (i != last)
+    copyEntity(last, i);
+  resize(last);
+}
+
+void ParticlePool::clear() {
+  EntityColumns::clear();
+  life.clear();
+  maxLife.clear();
+  alpha.clear();
+}
+
+void ParticlePool::copyEntity(size_t from, size_t to) {
+  EntityColumns::copyEntity(from, to);
+  life[to] = life[from];
+  maxLife[to] = maxLife[from];
+  alpha[to] = alpha[from];
+}
+
+void ParticlePool::resize(size_t n) {
+  EntityColumns::resize(n);
+  life.resize(n);
+  maxLife.resize(n);
+  alpha.resize(n);
+}
+
+void ParticlePool::update(bool save) {
+  integrate(save);
+
+  size_t n = size();
+  kernel_age(life.data(), maxLife.data(), alpha.data(), n);
+
+  if (s_gameOptions.stableOrder) {
+    // Drop the expired particles in a single pass, keeping the order.
+    size_t alive = 0;
+    for (size_t i = 0; i < n; ++i) {
+      if (life[i] < maxLife[i]) {
+        if (alive != i)
+          copyEntity(i, alive);
+        ++alive;
+      }
+    }
+    resize(alive);
+  } else {
+    // Only the expired particles are touched: each is overwritten by the last
+    // one, which is then checked in turn.
+    for (size_t i = 0; i < n;) {
+      if (!(life[i] < maxLife[i])) {
+        if (i != --n)
+          copyEntity(n, i);
+        continue;
+      }
+      ++i;
+    }
+    resize(n);
+  }
+}
+
+void game_init(float shipW, float shipH, float backgroundW, const GameHooks &hooks) {
+  s_hooks = hooks;
+  s_backgroundW = backgroundW;
+  s_oldBackgroundX = s_backgroundX = 0;
+  s_enemySpawnCounter = 0;
+  s_tick = 0;
+  memset(s_keys, 0, sizeof(s_keys));
+  InputEvent event;
+  while (s_input.pop(event)) {
+  }
+  s_pendingShots = 0;
+
+  s_ship = std::make_unique<Ship>(ASSUMED_W / 2, ASSUMED_H / 2, shipW, shipH);
+  s_bullets.clear();
+  s_enemies.clear();
+  s_particles.init(s_gameOptions.maxParticles);
+}
+
+uint32_t game_tick() {
+  return s_tick;
+}
+
+void game_key(int keyCode, bool down) {
+  if (keyCode < 0 || keyCode >= GAME_MAX_KEYCODES)
+    return;
+  s_keys[keyCode] = down;
+  if (down && keyCode == SAPP_KEYCODE_SPACE)
+    ++s_pendingShots;
+}
+
+bool game_post_key(int keyCode, bool down, uint64_t time) {
+  return s_input.push(InputEvent{time, keyCode, down});
+}
+
+void game_fire() {
+  createBullet(s_ship->x + s_ship->width, s_ship->y + s_ship->height / 2.0 - 2.5);
+}
+
+void createBullet(float x, float y) {
+  s_bullets.push(x, y, 5, 5, 8 * 2, 0);
+}
+
+void createEnemy(float x, float y) {
+  s_enemies.push(x, y, 64, 64, -2 * 2, 0);
+}
+
+/// An axis-aligned box, loaded from the columns once per test loop.
+struct AABB {
+  float x, y, width, height;
+
+  AABB(const EntityColumns &e, size_t i)
+      : x(e.x[i]), y(e.y[i]), width(e.width[i]), height(e.height[i]) {}
+  explicit AABB(const Actor &a) : x(a.x), y(a.y), width(a.width), height(a.height) {}
+};
+
+static bool checkCollision(const AABB &a, const AABB &b) {
+  return a.x < b.x + b.width && a.x + a.width > b.x && a.y < b.y + b.height && a.y + a.height > b.y;
+}
+
+void createExplosion(float x, float y) {
+  s_particles.spawnBurst(x, y, 50);
+  if (s_hooks.explosion)
+    s_hooks.explosion();
+}
+
+void game_drain_input() {
+  InputEvent event;
+  while (s_input.pop(event)) {
+    if (event.down && event.keyCode == SAPP_KEYCODE_SPACE)
+      continue;
+    if (s_hooks.input)
+      s_hooks.input(event);
+    game_key(event.keyCode, event.down);
+  }
+}
+
+// Update game state
+void update_game_state(bool save) {
+  InputEvent event;
+  while (s_input.pop(event)) {
+    if (s_hooks.input)
+      s_hooks.input(event);
+    game_key(event.keyCode, event.down);
+  }
+  for (; s_pendingShots; --s_pendingShots)
+    game_fire();
+
+  ++s_tick;
+  if (save)
+    s_oldBackgroundX = s_backgroundX;
+  s_backgroundX -= s_backgroundSpeed;
+  if (s_backgroundX <= -s_backgroundW) {
+    s_backgroundX += s_backgroundW;
+    s_oldBackgroundX += s_backgroundW;
+  }
+
+  s_ship->update(save);
+
+  s_bullets.integrate(save);
+  for (size_t i = 0; i < s_bullets.size();) {
+    if (s_bullets.x[i] > ASSUMED_W) {
+      s_bullets.remove(i);
+      continue;
+    }
+    ++i;
+  }
+
+  ++s_enemySpawnCounter;
+  if (s_enemySpawnCounter >= s_enemySpawnRate) {
+    float y = mathRandom(ASSUMED_H - 64);
+    createEnemy(ASSUMED_W, y);
+    s_enemySpawnCounter = 0;
+  }
+
+  s_enemies.integrate(save);
+
+  size_t numBullets = s_bullets.size();
+  s_bulletHit.assign(numBullets, 0);
+  bool useGrid = s_gameOptions.gridBroadphase && numBullets && !s_enemies.empty();
+  if (useGrid) {
+    s_bulletGrid.build(
+        s_bullets.x.data(),
+        s_bullets.y.data(),
+        s_bullets.width.data(),
+        s_bullets.height.data(),
+        numBullets);
+  }
+
+  for (size_t i = 0; i < s_enemies.size();) {
+    if (s_enemies.x[i] < -s_enemies.width[i]) {
+      s_enemies.remove(i);
+      continue;
+    }
+
+    AABB enemy(s_enemies, i);
+    bool destroy = false;
+    auto hitBullet = [&enemy, &destroy](size_t j) {
+      if (!destroy)
+        createExplosion(enemy.x + enemy.width / 2, enemy.y + enemy.height / 2);
+      s_bulletHit[j] = 1;
+      destroy = true;
+    };
+
+    if (checkCollision(AABB(*s_ship), enemy)) {
+      createExplosion(enemy.x + enemy.width / 2, enemy.y + enemy.height / 2);
+      destroy = true;
+    } else if (useGrid) {
+      s_bulletGrid.query(enemy.x, enemy.y, enemy.width, enemy.height, s_candidates);
+      for (uint32_t j : s_candidates) {
+        if (!s_bulletHit[j] && checkCollision(AABB(s_bullets, j), enemy))
+          hitBullet(j);
+      }
+    } else {
+      for (size_t j = 0; j < numBullets; ++j) {
+        if (!s_bulletHit[j] && checkCollision(AABB(s_bullets, j), enemy))
+          hitBullet(j);
+      }
+    }
+    if (destroy) {
+      s_enemies.remove(i);
+      continue;
+    }
+    ++i;
+  }
+  s_bullets.removeMarked(s_bulletHit);
+
+  s_particles.update(save);
+}
+
+void game_snapshot(GameSnapshot &out) {
+  out.ship = *s_ship;
+  out.oldBackgroundX = s_oldBackgroundX;
+  out.backgroundX = s_backgroundX;
+  out.bullets = s_bullets;
+  out.enemies = s_enemies;
+  out.particles = static_cast<const EntityColumns &>(s_particles);
+  out.particleAlpha = s_particles.alpha;
+  out.tick = s_tick;
+}
+
+namespace {
+/// FNV-1a, fed with the raw bits of the state.
+class Hasher {
+  uint64_t h_ = 14695981039346656037ull;
+
+ public:
+  void add(const void *data, size_t size) {
+    auto *p = (const unsigned char *)data;
+    for (size_t i = 0; i < size; ++i) {
+      h_ ^= p[i];
+      h_ *= 1099511628211ull;
+    }
+  }
+  void add(float v) {
+    add(&v, sizeof(v));
+  }
+  void add(uint64_t v) {
+    add(&v, sizeof(v));
+  }
+  void addActor(const Actor &a) {
+    add(a.x);
+    add(a.y);
+    add(a.width);
+    add(a.height);
+    add(a.velX);
+    add(a.velY);
+  }
+  void addColumn(const std::vector<float> &column) {
+    add((uint64_t)column.size());
+    add(column.data(), column.size() * sizeof(float));
+  }
+  void addColumns(const EntityColumns &e) {
+    addColumn(e.x);
+    addColumn(e.y);
+    addColumn(e.width);
+    addColumn(e.height);
+    addColumn(e.velX);
+    addColumn(e.velY);
+  }
+  uint64_t get() const {
+    return h_;
+  }
+};
+} // namespace
+
+uint64_t game_checksum() {
+  Hasher h;
+  h.add(s_backgroundX);
+  h.add((uint64_t)s_enemySpawnCounter);
+  h.addActor(*s_ship);
+  h.addColumns(s_bullets);
+  h.addColumns(s_enemies);
+  h.addColumns(s_particles);
+  h.addColumn(s_particles.life);
+  h.addColumn(s_particles.maxLife);
+  return h.get();
+}
@@ -0,0 +1,246 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+// The game simulation, independent of sokol_gfx and ImGui, so that it can be
+// driven both by the demo window and by the headless demo_bench.
+
+static const float PHYS_FPS = 60;
+static const float PHYS_DT = 1.0f / PHYS_FPS;
+static const float ASSUMED_W = 800;
+static const float INV_ASSUMED_W = 1.0f / ASSUMED_W;
+static const float ASSUMED_H = 600;
+static const float INV_ASSUMED_H = 1.0f / ASSUMED_H;
+
+/// Number of entries in s_keys, indexed by sapp_keycode.
+static const int GAME_MAX_KEYCODES = 512;
+
+/// Return a random number in [0, range) from the seeded game RNG.
+double mathRandom(double range);
+
+/// Knobs that change how the simulation runs rather than what it models.
+struct GameOptions {
+  /// Remove dead entities with erase()/stable compaction, keeping the
+  /// remaining ones in spawn order. By default they are removed in O(1) by
+  /// moving the last entity into the hole, which reorders the containers.
+  bool stableOrder = false;
+  /// Find bullet/enemy collision candidates with a uniform grid instead of
+  /// testing every pair. Both produce exactly the same results.
+  bool gridBroadphase = true;
+  /// Capacity of the particle pool, applied by game_init().
+  size_t maxParticles = 1 << 16;
+};
+
+extern GameOptions s_gameOptions;
+
+/// A single free-standing actor. Only the ship is stored this way; everything
+/// else that exists in numbers lives in EntityColumns.
+class Actor {
+ public:
+  float oldX, oldY;
+  float x, y, width, height, velX, velY;
+
+  explicit Actor(float x, float y, float width, float height, float velX, float velY)
+      : oldX(x), oldY(y), x(x), y(y), width(width), height(height), velX(velX), velY(velY) {}
+
+  void update(bool save) {
+    if (save) {
+      oldX = x;
+      oldY = y;
+    }
+    x += velX;
+    y += velY;
+  }
+
+  float curX(float dt) const {
+    return x + (x - oldX) * dt;
+  }
+  float curY(float dt) const {
+    return y + (y - oldY) * dt;
+  }
+};
+
+class Ship : public Actor {
+ public:
+  float speed = 5 * 2;
+  explicit Ship(float x, float y, float width, float height) : Actor(x, y, width, height, 0, 0) {}
+
+  void update(bool save);
+};
+
+/// Structure-of-arrays storage for one archetype of entity. All columns always
+/// have the same length and entity \c i is at index \c i in every column.
+class EntityColumns {
+ public:
+  std::vector<float> x, y, oldX, oldY, velX, velY, width, height;
+
+  size_t size() const {
+    return x.size();
+  }
+  bool empty() const {
+    return x.empty();
+  }
+
+  void reserve(size_t n);
+  void push(float x, float y, float width, float height, float velX, float velY);
+  /// Remove entity \p i, preserving the order of the rest.
+  void removeAt(size_t i);
+  /// Remove entity \p i in O(1) by moving the last entity into its place.
+  void swapRemove(size_t i);
+  /// Remove entity \p i with removeAt() or swapRemove(), depending on
+  /// s_gameOptions.stableOrder.
+  void remove(size_t i) {
+    if (s_gameOptions.stableOrder)
+      removeAt(i);
+    else
+      swapRemove(i);
+  }
+  /// Remove all entities whose entry in \p marks is non-zero in a single pass,
+  /// honoring s_gameOptions.stableOrder. On return \p marks is all zeros and
+  /// has one entry per remaining entity.
+  void removeMarked(std::vector<uint8_t> &marks);
+  void clear();
+  /// Copy entity \p from over entity \p to. Used by compaction passes.
+  void copyEntity(size_t from, size_t to);
+  /// Grow or shrink to \p n entities. New entries are uninitialized.
+  void resize(size_t n);
+
+  /// Advance every entity by its velocity, recording the old positions first
+  /// if \p save is set.
+  void integrate(bool save);
+  /// Write the positions interpolated by \p dt between the old and current
+  /// position into \p outX and \p outY, which must have room for size()
+  /// entries.
+  void interpolate(float dt, float *outX, float *outY) const;
+  /// Like interpolate(), for entities [\p begin, \p end) only. \p outX and
+  /// \p outY are indexed from 0, not from \p begin.
+  void interpolate(size_t begin, size_t end, float dt, float *outX, float *outY) const;
+};
+
+/// The single particle buffer shared by all explosions. Its capacity is
+/// reserved up front and never grows, so spawning and expiring particles
+/// doesn't touch the heap; bursts that don't fit are clipped.
+///
+/// On top of the common columns each particle has its age (\c life), the age
+/// at which it dies (\c maxLife) and the alpha derived from the two.
+class ParticlePool : public EntityColumns {
+  size_t capacity_ = 0;
+
+ public:
+  std::vector<float> life, maxLife, alpha;
+
+  size_t capacity() const {
+    return capacity_;
+  }
+  /// Drop all particles and reserve room for \p capacity of them.
+  void init(size_t capacity);
+
+  /// Add up to \p count particles at (x, y) with random velocities, sizes and
+  /// life spans, as one bulk write into the columns. Returns the number of
+  /// particles actually added.
+  size_t spawnBurst(float x, float y, size_t count);
+
+  void removeAt(size_t i);
+  void swapRemove(size_t i);
+  void remove(size_t i) {
+    if (s_gameOptions.stableOrder)
+      removeAt(i);
+    else
+      swapRemove(i);
+  }
+  void clear();
+  void copyEntity(size_t from, size_t to);
+  void resize(size_t n);
+
+  /// Integrate all particles, age them and drop the ones that have expired.
+  void update(bool save);
+};
+
+/// A key press or release from game_post_key(), waiting for the next tick.
+struct InputEvent {
+  /// When the event was posted, in the embedder's clock.
+  uint64_t time;
+  int32_t keyCode;
+  bool down;
+};
+
+/// Notifications from the simulation to the embedder (sound, etc). Any of them
+/// may be null.
+struct GameHooks {
+  void (*explosion)() = nullptr;
+  /// Called by update_game_state() for every posted event it applies, before
+  /// applying it and while game_tick() is still the number of the previous
+  /// tick, which is what an input log records.
+  void (*input)(const InputEvent &event) = nullptr;
+};
+
+extern bool s_keys[GAME_MAX_KEYCODES];
+
+extern std::unique_ptr<Ship> s_ship;
+extern EntityColumns s_bullets;
+extern EntityColumns s_enemies;
+extern ParticlePool s_particles;
+
+extern float s_oldBackgroundX;
+extern float s_backgroundX;
+
+/// Reset the game to its initial state. The sizes come from the images, which
+/// the simulation itself doesn't load.
+void game_init(float shipW, float shipH, float backgroundW, const GameHooks &hooks);
+/// Reseed the RNG used by mathRandom().
+void game_seed(uint64_t seed);
+/// The seed to use when none was given on the command line: $GAME_SEED, or 1.
+uint64_t game_default_seed();
+
+/// Apply a key press or release from the player: update s_keys and, on space,
+/// fire a bullet at the start of the next tick. This is the only way input
+/// reaches the simulation, which is what makes input logs replayable.
+void game_key(int keyCode, bool down);
+/// Queue a key press or release, posted at \p time, for the start of the next
+/// update_game_state(), which applies it with game_key(). May be called from
+/// one thread while another runs the ticks. Returns false, dropping the event,
+/// if the queue is full.
+bool game_post_key(int keyCode, bool down, uint64_t time);
+/// Apply the posted input without running a tick, for while the game is
+/// paused, so that the queue doesn't fill up. Keys still update s_keys, but
+/// space presses are discarded instead of firing on the first tick after the
+/// pause. Every applied event goes through GameHooks::input, so a replay of
+/// the log applies exactly the same ones.
+void game_drain_input();
+/// Fire a bullet from the current ship position.
+void game_fire();
+void createBullet(float x, float y);
+void createEnemy(float x, float y);
+/// Spawn the 50 particles of an explosion centered at (x, y).
+void createExplosion(float x, float y);
+
+/// Number of update_game_state() calls since game_init().
+uint32_t game_tick();
+
+/// Advance the simulation by one physics tick, after applying the posted input
+/// and firing the bullets requested since the last tick. \p save is true for
+/// the first tick of a frame and records the old positions used for
+/// interpolation.
+void update_game_state(bool save);
+
+/// A copy of everything the renderers read, so that the game can be drawn
+/// while the simulation keeps running on another thread.
+struct GameSnapshot {
+  Actor ship{0, 0, 0, 0, 0, 0};
+  float oldBackgroundX = 0, backgroundX = 0;
+  EntityColumns bullets, enemies;
+  /// The particles without their ages, and their alpha.
+  EntityColumns particles;
+  std::vector<float> particleAlpha;
+  uint32_t tick = 0;
+};
+
+/// Copy the current state into \p out, reusing its storage.
+void game_snapshot(GameSnapshot &out);
+
+/// Hash of the simulation state, excluding the interpolation-only old
+/// positions. Two runs fed the same seed and input produce the same value.
+uint64_t game_checksum();
@@ -0,0 +1,145 @@
+#include "game_render.h"
+#include "game.h"
+#include "job_system.h"
+
+#include <vector>
+
+static uint32_t color32(float r, float g, float b, float a) {
+  return ((uint32_t)(255 * a) & 0xFF) << 24 | ((uint32_t)(255 * b) & 0xFF) << 16 |
+      ((uint32_t)(255 * g) & 0xFF) << 8 | ((uint32_t)(255 * r) & 0xFF);
+}
+
+static const uint32_t WHITE = 0xFFFFFFFF;
+
+static float backgroundX(const GameSnapshot &game, float dt) {
+  return game.oldBackgroundX + (game.backgroundX - game.oldBackgroundX) * dt;
+}
+
+static void interpolate(
+    const EntityColumns &columns,
+    float dt,
+    std::vector<float> &outX,
+    std::vector<float> &outY) {
+  outX.resize(columns.size());
+  outY.resize(columns.size());
+  columns.interpolate(dt, outX.data(), outY.data());
+}
+
+/// Particles per job when interpolating them in parallel.
+static const size_t PARTICLE_GRAIN = 8192;
+
+void prepare_game_render(const GameSnapshot &game, float dt, GameRenderData &out, JobSystem *jobs) {
+  out.game = &game;
+  out.dt = dt;
+  interpolate(game.bullets, dt, out.bulletX, out.bulletY);
+  interpolate(game.enemies, dt, out.enemyX, out.enemyY);
+
+  const EntityColumns &particles = game.particles;
+  if (!jobs || particles.size() <= PARTICLE_GRAIN) {
+    interpolate(particles, dt, out.particleX, out.particleY);
+    return;
+  }
+  out.particleX.resize(particles.size());
+  out.particleY.resize(particles.size());
+  jobs->parallelFor(particles.size(), PARTICLE_GRAIN, [&](size_t begin, size_t end) {
+    particles.interpolate(begin, end, dt, &out.particleX[begin], &out.particleY[begin]);
+  });
+}
+
+void render_game_batched(
+    const GameRenderData &frame,
+    SpriteBatch &batch,
+    ImDrawList *dl,
+    ImVec2 org,
+    ImVec2 size,
+    const GameTextures &textures,
+    float backgroundW) {
+  const GameSnapshot &game = *frame.game;
+  float dt = frame.dt;
+  batch.setTransform(org, ImVec2{size.x * INV_ASSUMED_W, size.y * INV_ASSUMED_H});
+
+  float bkgX = backgroundX(game, dt);
+  batch.begin(dl, textures.background, 2);
+  batch.rect(bkgX, 0, backgroundW, ASSUMED_H, WHITE);
+  batch.rect(bkgX + backgroundW, 0, backgroundW, ASSUMED_H, WHITE);
+  batch.end();
+
+  batch.begin(dl, textures.ship, 1);
+  batch.rect(game.ship.curX(dt), game.ship.curY(dt), game.ship.width, game.ship.height, WHITE);
+  batch.end();
+
+  const uint32_t bulletColor = color32(1, 1, 0, 1);
+  batch.beginSolid(dl, game.bullets.size());
+  for (size_t i = 0, e = game.bullets.size(); i < e; ++i) {
+    batch.rect(
+        frame.bulletX[i],
+        frame.bulletY[i],
+        game.bullets.width[i],
+        game.bullets.height[i],
+        bulletColor);
+  }
+  batch.end();
+
+  batch.begin(dl, textures.enemy, game.enemies.size());
+  for (size_t i = 0, e = game.enemies.size(); i < e; ++i) {
+    batch.rect(
+        frame.enemyX[i], frame.enemyY[i], game.enemies.width[i], game.enemies.height[i], WHITE);
+  }
+  batch.end();
+
+  batch.beginSolid(dl, game.particles.size());
+  for (size_t i = 0, e = game.particles.size(); i < e; ++i) {
+    batch.rect(
+        frame.particleX[i] - game.particles.width[i] / 2,
+        frame.particleY[i] - game.particles.height[i] / 2,
+        game.particles.width[i],
+        game.particles.height[i],
+        color32(1, 0.5, 0, game.particleAlpha[i]));
+  }
+  batch.end();
+}
+
+void render_game_instanced(const GameRenderData &frame, QuadRenderer &quads, float backgroundW) {
+  const GameSnapshot &game = *frame.game;
+  float dt = frame.dt;
+  quads.clear();
+
+  float bkgX = backgroundX(game, dt);
+  quads.add(SPRITE_BACKGROUND, bkgX, 0, backgroundW, ASSUMED_H, WHITE);
+  quads.add(SPRITE_BACKGROUND, bkgX + backgroundW, 0, backgroundW, ASSUMED_H, WHITE);
+
+  const Actor &ship = game.ship;
+  quads.add(SPRITE_SHIP, ship.curX(dt), ship.curY(dt), ship.width, ship.height, WHITE);
+
+  QuadRenderer::Sprite white = quads.white();
+  const uint32_t bulletColor = color32(1, 1, 0, 1);
+  for (size_t i = 0, e = game.bullets.size(); i < e; ++i) {
+    quads.add(
+        white,
+        frame.bulletX[i],
+        frame.bulletY[i],
+        game.bullets.width[i],
+        game.bullets.height[i],
+        bulletColor);
+  }
+
+  for (size_t i = 0, e = game.enemies.size(); i < e; ++i) {
+    quads.add(
+        SPRITE_ENEMY,
+        frame.enemyX[i],
+        frame.enemyY[i],
+        game.enemies.width[i],
+        game.enemies.height[i],
+        WHITE);
+  }
+
+  for (size_t i = 0, e = game.particles.size(); i < e; ++i) {
+    quads.add(
+        white,
+        frame.particleX[i] - game.particles.width[i] / 2,
+        frame.particleY[i] - game.particles.height[i] / 2,
+        game.particles.width[i],
+        game.particles.height[i],
+        color32(1, 0.5, 0, game.particleAlpha[i]));
+  }
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include "quad_renderer.h"
+#include "sprite_batch.h"
+
+#include <vector>
+
+struct GameSnapshot;
+class JobSystem;
+
+// Drawing of the game layer, shared by the demo and the headless render_bench.
+// There are two interchangeable paths: SpriteBatch writes ImGui vertices, and
+// QuadRenderer draws instances with its own sokol_gfx pipeline.
+
+/// ImGui textures of the game images, for the SpriteBatch path.
+struct GameTextures {
+  ImTextureID background, ship, enemy;
+};
+
+/// Order of the images in the QuadRenderer atlas.
+enum GameSprite { SPRITE_BACKGROUND, SPRITE_SHIP, SPRITE_ENEMY, SPRITE_COUNT };
+
+/// A GameSnapshot with the positions of its entities interpolated: the part of
+/// drawing the game that doesn't touch ImGui or sokol_gfx, so it can be done on
+/// other threads before the UI is built.
+struct GameRenderData {
+  const GameSnapshot *game = nullptr;
+  float dt = 0;
+  std::vector<float> bulletX, bulletY, enemyX, enemyY, particleX, particleY;
+};
+
+/// Interpolate \p game by \p dt into \p out, which keeps a reference to
+/// \p game. The particles are split over \p jobs if it isn't null.
+void prepare_game_render(
+    const GameSnapshot &game,
+    float dt,
+    GameRenderData &out,
+    JobSystem *jobs = nullptr);
+
+/// Draw \p frame into the rectangle \p org .. \p org + \p size of \p dl, one
+/// SpriteBatch run per layer.
+void render_game_batched(
+    const GameRenderData &frame,
+    SpriteBatch &batch,
+    ImDrawList *dl,
+    ImVec2 org,
+    ImVec2 size,
+    const GameTextures &textures,
+    float backgroundW);
+
+/// Fill \p quads with \p frame, in game units. The caller uploads it and adds
+/// it to a draw list.
+void render_game_instanced(const GameRenderData &frame, QuadRenderer &quads, float backgroundW);
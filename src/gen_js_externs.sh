@@ -1,7 +1,7 @@
 #!/bin/bash
 
-../tools/ffigen.py js js_externs.c sokol_imgui.h,cimgui.h > js_externs.js
-../tools/ffigen.py cwrap js_externs.c sokol_imgui.h,cimgui.h > tmp-cwrap.c
+../tools/ffigen.py --split-structs --views=ImVec2 js js_externs.c sokol_imgui.h,cimgui.h > js_externs.js
+../tools/ffigen.py --split-structs cwrap js_externs.c sokol_imgui.h,cimgui.h > tmp-cwrap.c
 
 cat << "EOF" - tmp-cwrap.c > js_externs_cwrap.c
 #define CIMGUI_DEFINE_ENUMS_AND_STRUCTS
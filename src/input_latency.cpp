@@ -0,0 +1,102 @@
+#include "input_latency.h"
+
+#include "sokol_gfx.h"
+#include "sokol_time.h"
+// Must be separate to avoid reordering.
+#include "sokol_debugtext.h"
+
+#include <algorithm>
+#include <cstdio>
+
+InputLatency::InputLatency() : buckets_(MAX_MS + 1) {}
+
+void InputLatency::consumed(uint32_t seq, uint64_t time) {
+  // Only an overlay statistic; if the render thread falls this far behind,
+  // losing a sample doesn't matter.
+  queue_.push(Input{seq, time});
+}
+
+void InputLatency::rendered(uint32_t seq) {
+  Input input;
+  while (queue_.pop(input))
+    waiting_.push_back(input);
+  // Sequence numbers only grow, so the drawn events are at the front.
+  while (!waiting_.empty() && (int32_t)(seq - waiting_.front().seq) >= 0) {
+    frame_.push_back(waiting_.front().time);
+    waiting_.pop_front();
+  }
+}
+
+void InputLatency::committed() {
+  uint64_t now = stm_now();
+  for (uint64_t time : frame_) {
+    double ms = stm_ms(stm_diff(now, time));
+    ++buckets_[std::min((unsigned)ms, MAX_MS)];
+    ++count_;
+    maxMs_ = std::max(maxMs_, ms);
+  }
+  frame_.clear();
+}
+
+unsigned InputLatency::percentile(double fraction) const {
+  uint64_t target = (uint64_t)(fraction * count_);
+  uint64_t sum = 0;
+  for (unsigned ms = 0; ms <= MAX_MS; ++ms) {
+    sum += buckets_[ms];
+    if (sum > target)
+      return ms + 1;
+  }
+  return MAX_MS;
+}
+
+void InputLatency::printOverlay() const {
+  if (!count_) {
+    sdtx_printf("input latency: no samples\n");
+    return;
+  }
+  sdtx_printf(
+      "input latency: %llu, p50 <%u p95 <%u p99 <%u max %.1f ms\n",
+      (unsigned long long)count_,
+      percentile(0.5),
+      percentile(0.95),
+      percentile(0.99),
+      maxMs_);
+
+  // 10 ms per row, the last one open-ended.
+  static constexpr unsigned ROW_MS = 10, ROWS = 8, BAR = 30;
+  uint64_t rows[ROWS] = {};
+  for (unsigned ms = 0; ms <= MAX_MS; ++ms)
+    rows[std::min(ms / ROW_MS, ROWS - 1)] += buckets_[ms];
+  uint64_t highest = *std::max_element(rows, rows + ROWS);
+  for (unsigned row = 0; row != ROWS; ++row) {
+    char bar[BAR + 1];
+    unsigned len = (unsigned)((rows[row] * BAR + highest - 1) / highest);
+    std::fill(bar, bar + len, '#');
+    bar[len] = 0;
+    if (row + 1 < ROWS)
+      sdtx_printf("%3u-%-3u %s\n", row * ROW_MS, (row + 1) * ROW_MS, bar);
+    else
+      sdtx_printf("%3u+    %s\n", row * ROW_MS, bar);
+  }
+}
+
+bool InputLatency::writeCsv(const char *path) const {
+  FILE *f = fopen(path, "w");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+  fprintf(f, "min_ms,max_ms,count\n");
+  for (unsigned ms = 0; ms < MAX_MS; ++ms)
+    fprintf(f, "%u,%u,%llu\n", ms, ms + 1, (unsigned long long)buckets_[ms]);
+  fprintf(f, "%u,,%llu\n", MAX_MS, (unsigned long long)buckets_[MAX_MS]);
+  bool ok = !ferror(f);
+  if (fclose(f) != 0)
+    ok = false;
+  if (!ok) {
+    perror(path);
+    return false;
+  }
+  printf("input latency: %llu samples written to %s\n", (unsigned long long)count_, path);
+  return true;
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "spsc_queue.h"
+
+#include <cstdint>
+#include <deque>
+#include <vector>
+
+/// Input-to-photon latency: the time from a key event to the sg_commit() of
+/// the first frame that shows its effect.
+///
+/// The event carries its stm_now() stamp to whatever consumes it (a
+/// simulation tick, possibly on another thread), which reports it with
+/// consumed() and the sequence number of the state it went into. The render
+/// thread reports with rendered() which state a frame draws, and after
+/// sg_commit() committed() records the latency of every event consumed up to
+/// that state.
+///
+/// The latencies are kept in a histogram of 1 ms buckets, shown by
+/// printOverlay() and written as CSV by writeCsv().
+class InputLatency {
+ public:
+  /// Latencies of this many ms or more share the last bucket.
+  static constexpr unsigned MAX_MS = 250;
+
+  InputLatency();
+
+  /// Event stamped \p time went into state \p seq. May be called from one
+  /// thread other than the render thread.
+  void consumed(uint32_t seq, uint64_t time);
+  /// The frame being built draws state \p seq.
+  void rendered(uint32_t seq);
+  /// The frame was committed now.
+  void committed();
+
+  uint64_t count() const {
+    return count_;
+  }
+
+  /// Print the sample count, percentiles and a coarse histogram with
+  /// sokol_debugtext, at the current cursor position.
+  void printOverlay() const;
+  /// Write the histogram to \p path as "min_ms,max_ms,count" rows. Returns false
+  /// if the file couldn't be written.
+  bool writeCsv(const char *path) const;
+
+ private:
+  struct Input {
+    uint32_t seq;
+    uint64_t time;
+  };
+
+  SpscQueue<Input, 256> queue_;
+  /// Consumed, but into a state that hasn't been drawn yet.
+  std::deque<Input> waiting_;
+  /// Drawn by the frame being built.
+  std::vector<uint64_t> frame_;
+
+  /// MAX_MS + 1 buckets.
+  std::vector<uint64_t> buckets_;
+  uint64_t count_ = 0;
+  double maxMs_ = 0;
+
+  /// The latency below which \p fraction of the samples are, rounded up to a
+  /// bucket.
+  unsigned percentile(double fraction) const;
+};
@@ -0,0 +1,99 @@
+#include "input_log.h"
+#include "game.h"
+
+#include <cstring>
+
+static const char LOG_MAGIC[4] = {'G', 'S', 'I', 'L'};
+static const uint32_t LOG_VERSION = 1;
+
+struct LogHeader {
+  char magic[4];
+  uint32_t version;
+  uint64_t seed;
+};
+static_assert(sizeof(LogHeader) == 16, "LogHeader must be packed");
+
+InputRecorder::~InputRecorder() {
+  if (f_)
+    fclose(f_);
+}
+
+void InputRecorder::write(const void *data, size_t size) {
+  if (fwrite(data, 1, size, f_) != size) {
+    perror("input log");
+    fclose(f_);
+    f_ = nullptr;
+  }
+}
+
+bool InputRecorder::open(const char *path, uint64_t seed) {
+  if (!(f_ = fopen(path, "wb"))) {
+    perror(path);
+    return false;
+  }
+  LogHeader header;
+  memcpy(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC));
+  header.version = LOG_VERSION;
+  header.seed = seed;
+  write(&header, sizeof(header));
+  return f_ != nullptr;
+}
+
+void InputRecorder::key(uint32_t tick, int keyCode, bool down) {
+  if (!f_)
+    return;
+  InputRecord rec{tick, down ? InputRecord::KeyDown : InputRecord::KeyUp, (uint16_t)keyCode};
+  write(&rec, sizeof(rec));
+}
+
+void InputRecorder::finish(uint32_t tick, uint64_t checksum) {
+  if (!f_)
+    return;
+  InputRecord rec{tick, InputRecord::End, 0};
+  write(&rec, sizeof(rec));
+  if (f_)
+    write(&checksum, sizeof(checksum));
+  if (f_) {
+    fclose(f_);
+    f_ = nullptr;
+  }
+}
+
+bool InputReplay::load(const char *path) {
+  FILE *f = fopen(path, "rb");
+  if (!f) {
+    perror(path);
+    return false;
+  }
+
+  events_.clear();
+  next_ = 0;
+  bool ok = false;
+  LogHeader header;
+  if (fread(&header, sizeof(header), 1, f) == 1 &&
+      memcmp(header.magic, LOG_MAGIC, sizeof(LOG_MAGIC)) == 0 && header.version == LOG_VERSION) {
+    seed_ = header.seed;
+    InputRecord rec;
+    while (fread(&rec, sizeof(rec), 1, f) == 1) {
+      if (rec.type == InputRecord::End) {
+        endTick_ = rec.tick;
+        ok = fread(&checksum_, sizeof(checksum_), 1, f) == 1;
+        break;
+      }
+      // Events must be in tick order.
+      if (rec.type > InputRecord::KeyDown || (!events_.empty() && rec.tick < events_.back().tick))
+        break;
+      events_.push_back(rec);
+    }
+  }
+  fclose(f);
+
+  if (!ok)
+    fprintf(stderr, "%s: not a valid input log\n", path);
+  return ok;
+}
+
+void InputReplay::apply(uint32_t tick) {
+  for (; next_ < events_.size() && events_[next_].tick <= tick; ++next_)
+    game_key(events_[next_].keyCode, events_[next_].type == InputRecord::KeyDown);
+}
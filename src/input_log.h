@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Recording and replay of the player's input, so that a run of the game can be
+// reproduced exactly: same seed, same key events at the same physics ticks,
+// same final state.
+//
+// The log is a binary file in host byte order (little-endian everywhere we
+// build): a header with the magic "GSIL", a format version and the RNG seed,
+// followed by 8-byte records (tick, type, key code). The last record is an End
+// record stamped with the final tick, followed by the game_checksum() at that
+// point.
+
+struct InputRecord {
+  enum Type : uint16_t { KeyUp = 0, KeyDown = 1, End = 2 };
+
+  /// Value of game_tick() when the event happened. It is applied right before
+  /// that tick runs.
+  uint32_t tick;
+  uint16_t type;
+  uint16_t keyCode;
+};
+static_assert(sizeof(InputRecord) == 8, "InputRecord must be packed");
+
+/// Writes an input log as the game runs.
+class InputRecorder {
+  FILE *f_ = nullptr;
+
+  void write(const void *data, size_t size);
+
+ public:
+  ~InputRecorder();
+
+  bool isOpen() const {
+    return f_ != nullptr;
+  }
+
+  /// Create \p path and write the header. Returns false on error.
+  bool open(const char *path, uint64_t seed);
+  /// Record a key event happening before tick \p tick.
+  void key(uint32_t tick, int keyCode, bool down);
+  /// Write the End record and the checksum, and close the file.
+  void finish(uint32_t tick, uint64_t checksum);
+};
+
+/// Reads an input log and feeds it back into the game.
+class InputReplay {
+  std::vector<InputRecord> events_;
+  size_t next_ = 0;
+  uint64_t seed_ = 0;
+  uint32_t endTick_ = 0;
+  uint64_t checksum_ = 0;
+
+ public:
+  /// Load the whole log from \p path. Returns false if it can't be read or is
+  /// malformed, including when it has no End record.
+  bool load(const char *path);
+
+  uint64_t seed() const {
+    return seed_;
+  }
+  /// The tick at which the recording stopped.
+  uint32_t endTick() const {
+    return endTick_;
+  }
+  /// game_checksum() at endTick() in the recorded run.
+  uint64_t checksum() const {
+    return checksum_;
+  }
+  bool finished(uint32_t tick) const {
+    return tick >= endTick_;
+  }
+
+  /// Start over from the first event.
+  void rewind() {
+    next_ = 0;
+  }
+  /// Pass every event recorded for \p tick to game_key(). Must be called once
+  /// per tick, in order, before update_game_state().
+  void apply(uint32_t tick);
+};
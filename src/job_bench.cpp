@@ -0,0 +1,183 @@
+// Headless scaling benchmark of JobSystem on the kind of per-window work that
+// the demo runs as jobs before building the UI. Every frame interpolates a
+// game snapshot full of particles, split with parallelFor(), and updates and
+// then formats a number of spreadsheet windows, the formatting of each window
+// depending on its update. The same frames run at each thread count and the
+// results are checked to be identical.
+//
+// Usage: job_bench [--frames=N] [--warmup=N] [--particles=N] [--windows=N]
+//                  [--cells=N] [--threads=N]
+//
+// By default it runs with 1, 2, 4, 8 and 16 threads; --threads=N runs only N.
+
+#include "game.h"
+#include "game_render.h"
+#include "job_system.h"
+#include "rng.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+struct Options {
+  long frames = 200;
+  long warmup = 20;
+  long particles = 1 << 20;
+  long windows = 16;
+  long cells = 4096;
+  long threads = 0;
+};
+
+static bool parseLong(const char *arg, const char *name, long *out) {
+  size_t len = strlen(name);
+  if (strncmp(arg, name, len) != 0 || arg[len] != '=')
+    return false;
+  *out = strtol(arg + len + 1, nullptr, 0);
+  return true;
+}
+
+static void usage() {
+  fprintf(
+      stderr,
+      "usage: job_bench [--frames=N] [--warmup=N] [--particles=N] [--windows=N] [--cells=N] "
+      "[--threads=N]\n");
+  exit(1);
+}
+
+static Options parseOptions(int argc, char **argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    if (parseLong(argv[i], "--frames", &opt.frames) ||
+        parseLong(argv[i], "--warmup", &opt.warmup) ||
+        parseLong(argv[i], "--particles", &opt.particles) ||
+        parseLong(argv[i], "--windows", &opt.windows) ||
+        parseLong(argv[i], "--cells", &opt.cells) ||
+        parseLong(argv[i], "--threads", &opt.threads)) {
+      continue;
+    }
+    usage();
+  }
+  if (opt.frames <= 0 || opt.warmup < 0 || opt.particles < 0 || opt.windows < 0 ||
+      opt.cells <= 0 || opt.threads < 0 || opt.threads > (long)JobSystem::MAX_THREADS) {
+    usage();
+  }
+  return opt;
+}
+
+/// One spreadsheet window: the numbers, their random steps and their text.
+struct Sheet {
+  Rng rng;
+  std::vector<float> numbers, steps;
+  std::vector<char> text;
+
+  static const size_t CELL_CHARS = 16;
+
+  Sheet(uint64_t seed, size_t cells)
+      : rng(seed), numbers(cells), steps(cells), text(cells * CELL_CHARS) {
+    rng.fill(numbers.data(), cells);
+    for (float &n : numbers)
+      n *= 100.0f;
+  }
+
+  void update() {
+    rng.fill(steps.data(), steps.size());
+    for (size_t i = 0, e = numbers.size(); i < e; ++i)
+      numbers[i] = std::min(std::max(numbers[i] + (steps[i] - 0.5f) * 2, 0.0f), 100.0f);
+  }
+
+  void format() {
+    for (size_t i = 0, e = numbers.size(); i < e; ++i)
+      snprintf(&text[i * CELL_CHARS], CELL_CHARS, "%.2f", numbers[i]);
+  }
+};
+
+/// Fill the game with about \p particles particles and return a snapshot of it.
+static void makeSnapshot(size_t particles, GameSnapshot &out) {
+  s_gameOptions.maxParticles = particles;
+  game_seed(1);
+  game_init(64, 64, ASSUMED_W, GameHooks{});
+  while (s_particles.size() + 50 <= particles)
+    createExplosion(mathRandom(ASSUMED_W), mathRandom(ASSUMED_H));
+  update_game_state(true);
+  game_snapshot(out);
+}
+
+struct Result {
+  double msPerFrame;
+  uint64_t checksum;
+};
+
+static Result run(const Options &opt, unsigned threads, const GameSnapshot &game) {
+  JobSystem jobs(threads);
+  GameRenderData render;
+  std::vector<Sheet> sheets;
+  for (long i = 0; i < opt.windows; ++i)
+    sheets.emplace_back(i + 1, opt.cells);
+  std::vector<JobSystem::JobHandle> waits;
+
+  auto start = std::chrono::steady_clock::now();
+  for (long frame = 0; frame < opt.warmup + opt.frames; ++frame) {
+    if (frame == opt.warmup)
+      start = std::chrono::steady_clock::now();
+    waits.clear();
+    waits.push_back(jobs.submit([&] { prepare_game_render(game, 0.5f, render, &jobs); }));
+    for (Sheet &sheet : sheets) {
+      JobSystem::JobHandle update = jobs.submit([&sheet] { sheet.update(); });
+      waits.push_back(jobs.submit([&sheet] { sheet.format(); }, {update}));
+    }
+    for (const JobSystem::JobHandle &job : waits)
+      jobs.wait(job);
+  }
+  double seconds =
+      std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+  // FNV-1a over everything the jobs wrote.
+  uint64_t hash = 0xcbf29ce484222325;
+  auto mix = [&hash](const void *data, size_t size) {
+    for (size_t i = 0; i < size; ++i)
+      hash = (hash ^ ((const unsigned char *)data)[i]) * 0x100000001b3;
+  };
+  mix(render.particleX.data(), render.particleX.size() * sizeof(float));
+  mix(render.particleY.data(), render.particleY.size() * sizeof(float));
+  for (const Sheet &sheet : sheets)
+    mix(sheet.text.data(), sheet.text.size());
+  return {seconds * 1e3 / opt.frames, hash};
+}
+
+int main(int argc, char **argv) {
+  Options opt = parseOptions(argc, argv);
+
+  GameSnapshot game;
+  makeSnapshot(opt.particles, game);
+  printf(
+      "particles=%zu windows=%ld cells=%ld frames=%ld hardware threads=%u\n",
+      game.particles.size(),
+      opt.windows,
+      opt.cells,
+      opt.frames,
+      std::thread::hardware_concurrency());
+
+  std::vector<unsigned> counts = {1, 2, 4, 8, 16};
+  if (opt.threads)
+    counts = {(unsigned)opt.threads};
+
+  printf("%7s %10s %8s\n", "threads", "ms/frame", "speedup");
+  double base = 0;
+  uint64_t checksum = 0;
+  bool same = true;
+  for (unsigned threads : counts) {
+    Result res = run(opt, threads, game);
+    if (!base) {
+      base = res.msPerFrame;
+      checksum = res.checksum;
+    }
+    same &= res.checksum == checksum;
+    printf("%7u %10.3f %7.2fx\n", threads, res.msPerFrame, base / res.msPerFrame);
+  }
+  printf("checksum %016llx, %s\n", (unsigned long long)checksum, same ? "same" : "MISMATCH");
+  return same ? 0 : 1;
+}
@@ -0,0 +1,170 @@
+#include "job_system.h"
+
+#include <algorithm>
+
+struct JobSystem::Job {
+  std::function<void()> fn;
+  /// Unfinished dependencies, plus one while submit() is still adding them.
+  std::atomic<unsigned> pending{1};
+  std::atomic<bool> done{false};
+  /// Guards continuations against a dependency finishing while submit()
+  /// registers with it.
+  std::mutex mutex;
+  /// Jobs that depend on this one and were submitted before it finished.
+  std::vector<JobHandle> continuations;
+};
+
+/// The system and queue index of the current thread, if it is a worker.
+static thread_local const JobSystem *t_system = nullptr;
+static thread_local unsigned t_index = 0;
+
+JobSystem::JobSystem(unsigned threads) {
+  if (!threads)
+    threads = std::max(1u, std::thread::hardware_concurrency());
+  for (unsigned i = 0; i < threads; ++i)
+    queues_.push_back(std::make_unique<Queue>());
+  for (unsigned i = 1; i < threads; ++i)
+    workers_.emplace_back([this, i] { workerLoop(i); });
+}
+
+JobSystem::~JobSystem() {
+  {
+    std::lock_guard<std::mutex> lock(sleepMutex_);
+    quit_ = true;
+  }
+  wake_.notify_all();
+  for (std::thread &t : workers_)
+    t.join();
+}
+
+unsigned JobSystem::self() const {
+  return t_system == this ? t_index : 0;
+}
+
+JobSystem::JobHandle JobSystem::submit(
+    std::function<void()> fn,
+    std::initializer_list<JobHandle> deps) {
+  auto job = std::make_shared<Job>();
+  job->fn = std::move(fn);
+  for (const JobHandle &dep : deps) {
+    std::lock_guard<std::mutex> lock(dep->mutex);
+    if (!dep->done.load(std::memory_order_acquire)) {
+      job->pending.fetch_add(1, std::memory_order_relaxed);
+      dep->continuations.push_back(job);
+    }
+  }
+  if (job->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+    enqueue(job);
+  return job;
+}
+
+void JobSystem::enqueue(JobHandle job) {
+  Queue &queue = *queues_[self()];
+  {
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    queue.jobs.push_back(std::move(job));
+  }
+  queued_.fetch_add(1, std::memory_order_release);
+  // Taking the lock orders this against a worker checking queued_ just before
+  // it sleeps, so the wakeup can't be lost.
+  { std::lock_guard<std::mutex> lock(sleepMutex_); }
+  wake_.notify_one();
+}
+
+JobSystem::JobHandle JobSystem::take(unsigned self) {
+  if (!queued_.load(std::memory_order_acquire))
+    return nullptr;
+  unsigned n = (unsigned)queues_.size();
+  for (unsigned k = 0; k < n; ++k) {
+    unsigned index = (self + k) % n;
+    Queue &queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.jobs.empty())
+      continue;
+    JobHandle job;
+    if (index == self) {
+      job = std::move(queue.jobs.back());
+      queue.jobs.pop_back();
+    } else {
+      job = std::move(queue.jobs.front());
+      queue.jobs.pop_front();
+    }
+    queued_.fetch_sub(1, std::memory_order_relaxed);
+    return job;
+  }
+  return nullptr;
+}
+
+void JobSystem::run(const JobHandle &job) {
+  job->fn();
+  job->fn = nullptr;
+
+  std::vector<JobHandle> ready;
+  {
+    std::lock_guard<std::mutex> lock(job->mutex);
+    job->done.store(true, std::memory_order_release);
+    ready.swap(job->continuations);
+  }
+  for (JobHandle &next : ready) {
+    if (next->pending.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      enqueue(std::move(next));
+  }
+}
+
+void JobSystem::wait(const JobHandle &job) {
+  unsigned index = self();
+  while (!job->done.load(std::memory_order_acquire)) {
+    if (JobHandle other = take(index))
+      run(other);
+    else
+      std::this_thread::yield();
+  }
+}
+
+void JobSystem::parallelFor(
+    size_t count,
+    size_t grain,
+    const std::function<void(size_t, size_t)> &fn) {
+  if (!grain)
+    grain = 1;
+  if (count <= grain) {
+    if (count)
+      fn(0, count);
+    return;
+  }
+
+  std::atomic<size_t> remaining{(count + grain - 1) / grain};
+  // The first piece runs here after the others have been offered to thieves.
+  for (size_t begin = grain; begin < count; begin += grain) {
+    size_t end = std::min(begin + grain, count);
+    submit([&fn, &remaining, begin, end] {
+      fn(begin, end);
+      remaining.fetch_sub(1, std::memory_order_acq_rel);
+    });
+  }
+  fn(0, grain);
+  remaining.fetch_sub(1, std::memory_order_acq_rel);
+
+  unsigned index = self();
+  while (remaining.load(std::memory_order_acquire)) {
+    if (JobHandle other = take(index))
+      run(other);
+    else
+      std::this_thread::yield();
+  }
+}
+
+void JobSystem::workerLoop(unsigned index) {
+  t_system = this;
+  t_index = index;
+  for (;;) {
+    if (JobHandle job = take(index)) {
+      run(job);
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    wake_.wait(lock, [this] { return quit_ || queued_.load(std::memory_order_acquire); });
+    if (quit_)
+      return;
+  }
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/// A small work-stealing job system.
+///
+/// Every thread has its own deque of ready jobs. A thread pushes the jobs it
+/// submits to the back of its own deque and takes work from the back too, so
+/// it tends to run what it just produced while the data is still in cache.
+/// When its deque is empty it steals the oldest job from the front of another
+/// thread's deque. The thread that created the system is thread 0 and runs
+/// jobs while it waits.
+///
+/// A job can depend on other jobs. It becomes ready, and is queued, when all
+/// of them have finished.
+class JobSystem {
+ public:
+  struct Job;
+  using JobHandle = std::shared_ptr<Job>;
+
+  /// Upper bound on the thread counts that embedders accept from the user.
+  static constexpr unsigned MAX_THREADS = 256;
+
+  /// Use \p threads threads in total, counting the calling thread, or all
+  /// hardware threads if 0.
+  explicit JobSystem(unsigned threads = 0);
+  ~JobSystem();
+
+  unsigned threads() const {
+    return (unsigned)queues_.size();
+  }
+
+  /// Run \p fn on some thread once every job in \p deps has finished.
+  JobHandle submit(std::function<void()> fn, std::initializer_list<JobHandle> deps = {});
+  /// Run jobs on this thread until \p job has finished.
+  void wait(const JobHandle &job);
+
+  /// Call fn(begin, end) for consecutive pieces of [0, count) of at most
+  /// \p grain indices, on all threads, and return when all of them are done.
+  void parallelFor(size_t count, size_t grain, const std::function<void(size_t, size_t)> &fn);
+
+ private:
+  struct Queue {
+    std::mutex mutex;
+    std::deque<JobHandle> jobs;
+  };
+
+  std::vector<std::unique_ptr<Queue>> queues_;
+  std::vector<std::thread> workers_;
+  /// Jobs in all the queues, so that idle workers know when to sleep.
+  std::atomic<size_t> queued_{0};
+  std::mutex sleepMutex_;
+  std::condition_variable wake_;
+  bool quit_ = false;
+
+  /// The queue of the calling thread: its own if it is a worker, else 0.
+  unsigned self() const;
+  void enqueue(JobHandle job);
+  /// Take a job from the back of queue \p self, or steal one from the front
+  /// of another queue.
+  JobHandle take(unsigned self);
+  void run(const JobHandle &job);
+  void workerLoop(unsigned index);
+};
@@ -0,0 +1,141 @@
+#include "native_view.h"
+
+#include "sokol_log.h"
+
+#include <jsi/jsi.h>
+
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <map>
+#include <memory>
+
+using namespace facebook::jsi;
+
+#ifndef NDEBUG
+/// A live or quarantined native_view_alloc() block. It is shared by the
+/// registry and by the views over it, and freed when the last one lets go.
+struct Allocation {
+  uint8_t *ptr;
+  size_t size;
+
+  ~Allocation() {
+    free(ptr);
+  }
+};
+
+/// Live allocations by address.
+static std::map<uintptr_t, std::shared_ptr<Allocation>> s_allocations;
+
+/// The live allocation containing [addr, addr + size), or null.
+static std::shared_ptr<Allocation> findAllocation(uintptr_t addr, size_t size) {
+  auto it = s_allocations.upper_bound(addr);
+  if (it == s_allocations.begin())
+    return nullptr;
+  --it;
+  const Allocation &alloc = *it->second;
+  uintptr_t begin = (uintptr_t)alloc.ptr;
+  if (addr < begin || size > alloc.size || addr - begin > alloc.size - size)
+    return nullptr;
+  return it->second;
+}
+#endif
+
+/// The storage of one ArrayBuffer: a borrowed native range.
+class NativeBuffer : public MutableBuffer {
+ public:
+  NativeBuffer(uint8_t *data, size_t size) : data_(data), size_(size) {}
+
+  size_t size() const override {
+    return size_;
+  }
+  uint8_t *data() override {
+    return data_;
+  }
+
+#ifndef NDEBUG
+  /// Keeps the allocation from being returned to malloc while the view is
+  /// alive.
+  std::shared_ptr<Allocation> alloc_;
+#endif
+
+ private:
+  uint8_t *const data_;
+  const size_t size_;
+};
+
+void install_native_views(Runtime &rt) {
+  const char *name = "__nativeArrayBuffer";
+  rt.global().setProperty(
+      rt,
+      name,
+      Function::createFromHostFunction(
+          rt,
+          PropNameID::forAscii(rt, name),
+          3,
+          [](Runtime &rt, const Value &, const Value *args, size_t count) -> Value {
+            if (count < 3 || !args[0].isNumber() || !args[1].isNumber() || !args[2].isNumber())
+              throw JSError(rt, "__nativeArrayBuffer(address, byteLength, alignment)");
+            double address = args[0].getNumber();
+            double byteLength = args[1].getNumber();
+            double alignment = args[2].getNumber();
+            if (!(byteLength >= 0 && byteLength <= INT32_MAX))
+              throw JSError(rt, "native view: invalid length");
+            auto addr = (uintptr_t)address;
+            auto size = (size_t)byteLength;
+            auto buffer = std::make_shared<NativeBuffer>((uint8_t *)addr, size);
+
+#ifndef NDEBUG
+            if (!addr || alignment < 1 || addr % (uintptr_t)alignment != 0)
+              throw JSError(rt, "native view: null or misaligned address");
+            buffer->alloc_ = findAllocation(addr, size);
+            if (!buffer->alloc_)
+              throw JSError(
+                  rt, "native view: range is not inside a live native_view_alloc() block");
+#else
+            (void)alignment;
+#endif
+            return ArrayBuffer(rt, std::move(buffer));
+          }));
+}
+
+extern "C" void *native_view_alloc(size_t size) {
+  void *ptr = calloc(1, size ? size : 1);
+  if (!ptr)
+    return nullptr;
+#ifndef NDEBUG
+  s_allocations.emplace(
+      (uintptr_t)ptr, std::shared_ptr<Allocation>(new Allocation{(uint8_t *)ptr, size}));
+#endif
+  return ptr;
+}
+
+extern "C" void native_view_free(void *ptr) {
+  if (!ptr)
+    return;
+#ifndef NDEBUG
+  auto it = s_allocations.find((uintptr_t)ptr);
+  if (it == s_allocations.end()) {
+    slog_func(
+        "ERROR", 1, 0, "native_view_free() of an unknown block", __LINE__, __FILE__, nullptr);
+    abort();
+  }
+  std::shared_ptr<Allocation> alloc = std::move(it->second);
+  s_allocations.erase(it);
+  // Views that the GC hasn't collected yet keep the block, but make any use of
+  // them visible.
+  if (alloc.use_count() > 1) {
+    slog_func(
+        "WARN",
+        2,
+        0,
+        "native_view_free() while views may still be alive; block quarantined",
+        __LINE__,
+        __FILE__,
+        nullptr);
+    memset(alloc->ptr, 0xFF, alloc->size);
+  }
+#else
+  free(ptr);
+#endif
+}
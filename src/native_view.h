@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstddef>
+
+namespace facebook::jsi {
+class Runtime;
+}
+
+// Typed-array views over native memory, so that JS can fill and read bulk data
+// (draw commands, body positions, particle buffers) with plain element
+// accesses instead of one _sh_ptr_read/write call per scalar.
+//
+// install_native_views() defines the global host function
+//
+//   __nativeArrayBuffer(address, byteLength, alignment)
+//
+// which returns an ArrayBuffer whose storage *is* the native range, without
+// copying. asciiz.js wraps it as nativeFloat32Array() and friends.
+//
+// Memory that is mapped should be allocated with native_view_alloc() and
+// released with native_view_free(). In debug builds this is checked: a view
+// must lie inside a live allocation and be aligned for its element type, and
+// memory freed while views may still reference it is poisoned (all bytes
+// 0xFF, so floats read as NaN) and kept until the garbage collector has
+// released every view, so a stale view never aliases memory that was reused.
+
+/// Define __nativeArrayBuffer() in \p rt. Must be called before any JS code
+/// that creates views runs.
+void install_native_views(facebook::jsi::Runtime &rt);
+
+/// Allocate \p size zeroed bytes that JS may map.
+extern "C" void *native_view_alloc(size_t size);
+/// Free memory allocated with native_view_alloc().
+extern "C" void native_view_free(void *ptr);
@@ -0,0 +1,597 @@
+#include "nbody.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <cstdio>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+extern "C" void nbody_advance(double *state, int n, double dt, int steps) {
+  double *x = state + NBODY_X * n, *y = state + NBODY_Y * n, *z = state + NBODY_Z * n;
+  double *vx = state + NBODY_VX * n, *vy = state + NBODY_VY * n, *vz = state + NBODY_VZ * n;
+  const double *mass = state + NBODY_MASS * n;
+
+  for (int step = 0; step < steps; ++step) {
+    for (int i = 0; i < n; ++i) {
+      double xi = x[i], yi = y[i], zi = z[i];
+      double vxi = vx[i], vyi = vy[i], vzi = vz[i];
+      double massi = mass[i];
+      for (int j = i + 1; j < n; ++j) {
+        double dx = xi - x[j];
+        double dy = yi - y[j];
+        double dz = zi - z[j];
+
+        double d2 = dx * dx + dy * dy + dz * dz;
+        double mag = dt / (d2 * std::sqrt(d2));
+
+        double massj = mass[j];
+        vxi -= dx * massj * mag;
+        vyi -= dy * massj * mag;
+        vzi -= dz * massj * mag;
+
+        vx[j] += dx * massi * mag;
+        vy[j] += dy * massi * mag;
+        vz[j] += dz * massi * mag;
+      }
+      vx[i] = vxi;
+      vy[i] = vyi;
+      vz[i] = vzi;
+    }
+
+    for (int i = 0; i < n; ++i) {
+      x[i] += dt * vx[i];
+      y[i] += dt * vy[i];
+      z[i] += dt * vz[i];
+    }
+  }
+}
+
+extern "C" double nbody_energy(const double *state, int n) {
+  const double *x = state + NBODY_X * n, *y = state + NBODY_Y * n, *z = state + NBODY_Z * n;
+  const double *vx = state + NBODY_VX * n, *vy = state + NBODY_VY * n,
+               *vz = state + NBODY_VZ * n;
+  const double *mass = state + NBODY_MASS * n;
+
+  double e = 0;
+  for (int i = 0; i < n; ++i) {
+    e += 0.5 * mass[i] * (vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i]);
+    for (int j = i + 1; j < n; ++j) {
+      double dx = x[i] - x[j];
+      double dy = y[i] - y[j];
+      double dz = z[i] - z[j];
+      e -= mass[i] * mass[j] / std::sqrt(dx * dx + dy * dy + dz * dz);
+    }
+  }
+  return e;
+}
+
+namespace {
+
+/// A fixed set of threads that run a function over a range of indices. The
+/// range is handed out in chunks from a shared counter, so threads that finish
+/// early take more of the work, which matters when the cost per body varies as
+/// in Barnes-Hut.
+class WorkerPool {
+ public:
+  /// Indices per chunk.
+  static constexpr int CHUNK = 64;
+
+  /// Start \p threads - 1 workers; the calling thread is the last one.
+  explicit WorkerPool(unsigned threads) {
+    for (unsigned i = 1; i < threads; ++i)
+      workers_.emplace_back([this] { workerLoop(); });
+  }
+  ~WorkerPool() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      quit_ = true;
+    }
+    start_.notify_all();
+    for (std::thread &t : workers_)
+      t.join();
+  }
+
+  unsigned threads() const {
+    return (unsigned)workers_.size() + 1;
+  }
+
+  /// Call fn(begin, end) for consecutive CHUNK-sized pieces of [0, count) on
+  /// all threads, and return when all of them are done.
+  void parallelFor(int count, const std::function<void(int, int)> &fn) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      fn_ = &fn;
+      count_ = count;
+      next_.store(0, std::memory_order_relaxed);
+      active_ = (unsigned)workers_.size();
+      ++generation_;
+    }
+    start_.notify_all();
+    runChunks();
+    std::unique_lock<std::mutex> lock(mutex_);
+    done_.wait(lock, [this] { return active_ == 0; });
+    fn_ = nullptr;
+  }
+
+ private:
+  std::vector<std::thread> workers_;
+  std::mutex mutex_;
+  std::condition_variable start_, done_;
+  const std::function<void(int, int)> *fn_ = nullptr;
+  int count_ = 0;
+  std::atomic<int> next_{0};
+  /// Workers still running the current parallelFor().
+  unsigned active_ = 0;
+  unsigned generation_ = 0;
+  bool quit_ = false;
+
+  void runChunks() {
+    for (;;) {
+      int begin = next_.fetch_add(CHUNK, std::memory_order_relaxed);
+      if (begin >= count_)
+        return;
+      (*fn_)(begin, std::min(begin + CHUNK, count_));
+    }
+  }
+
+  void workerLoop() {
+    unsigned seen = 0;
+    for (;;) {
+      {
+        std::unique_lock<std::mutex> lock(mutex_);
+        start_.wait(lock, [&] { return quit_ || generation_ != seen; });
+        if (quit_)
+          return;
+        seen = generation_;
+      }
+      runChunks();
+      std::lock_guard<std::mutex> lock(mutex_);
+      if (--active_ == 0)
+        done_.notify_one();
+    }
+  }
+};
+
+/// Barnes-Hut octree over the current positions. Bodies are referenced through
+/// a permutation, so that every node covers a contiguous range of it, and the
+/// leaves read a copy of the bodies in that order. Visiting the bodies in the
+/// same order keeps consecutive traversals on mostly the same nodes.
+class Octree {
+ public:
+  struct Node {
+    /// Center of mass and total mass.
+    double x, y, z, mass;
+    /// Edge length of the cube.
+    double size;
+    /// Index of the first child in nodes_, or -1 for a leaf.
+    int firstChild;
+    /// Number of children, stored consecutively.
+    int numChildren;
+    /// The bodies of the node: order_[begin, begin + count).
+    int begin, count;
+  };
+
+  void build(const double *x, const double *y, const double *z, const double *mass, int n);
+
+  /// The index of the \p k-th body in tree order.
+  int body(int k) const {
+    return order_[k];
+  }
+
+  /// Add the acceleration at (px, py, pz) to (ax, ay, az) and the potential
+  /// there to *phi. Bodies at exactly that position, like the one whose
+  /// acceleration this is, don't contribute.
+  void accumulate(
+      double px,
+      double py,
+      double pz,
+      double theta,
+      double *ax,
+      double *ay,
+      double *az,
+      double *phi) const;
+
+ private:
+  /// Leaves hold up to this many bodies, and bodies closer together than the
+  /// depth limit allows stay in one leaf.
+  static constexpr int LEAF_SIZE = 8;
+  static constexpr int MAX_DEPTH = 32;
+
+  struct Body {
+    double x, y, z, mass;
+  };
+
+  const double *x_ = nullptr, *y_ = nullptr, *z_ = nullptr, *mass_ = nullptr;
+  std::vector<Node> nodes_;
+  std::vector<int> order_, scratch_;
+  /// The bodies in tree order.
+  std::vector<Body> sorted_;
+
+  void buildNode(int index, double cx, double cy, double cz, double half, int depth);
+};
+
+void Octree::build(const double *x, const double *y, const double *z, const double *mass, int n) {
+  x_ = x;
+  y_ = y;
+  z_ = z;
+  mass_ = mass;
+  order_.resize(n);
+  scratch_.resize(n);
+  for (int i = 0; i < n; ++i)
+    order_[i] = i;
+
+  double minX = x[0], maxX = x[0], minY = y[0], maxY = y[0], minZ = z[0], maxZ = z[0];
+  for (int i = 1; i < n; ++i) {
+    minX = std::min(minX, x[i]);
+    maxX = std::max(maxX, x[i]);
+    minY = std::min(minY, y[i]);
+    maxY = std::max(maxY, y[i]);
+    minZ = std::min(minZ, z[i]);
+    maxZ = std::max(maxZ, z[i]);
+  }
+  double half = 0.5 * std::max({maxX - minX, maxY - minY, maxZ - minZ}) * 1.0001 + 1e-9;
+
+  nodes_.clear();
+  nodes_.push_back(Node{0, 0, 0, 0, 2 * half, -1, 0, 0, n});
+  buildNode(0, 0.5 * (minX + maxX), 0.5 * (minY + maxY), 0.5 * (minZ + maxZ), half, 0);
+
+  sorted_.resize(n);
+  for (int k = 0; k < n; ++k) {
+    int i = order_[k];
+    sorted_[k] = Body{x[i], y[i], z[i], mass[i]};
+  }
+}
+
+void Octree::buildNode(int index, double cx, double cy, double cz, double half, int depth) {
+  int begin = nodes_[index].begin, count = nodes_[index].count;
+
+  if (count > LEAF_SIZE && depth < MAX_DEPTH) {
+    // Partition the bodies into octants with a counting sort through scratch_.
+    int counts[8] = {};
+    auto octant = [&](int body) {
+      return (x_[body] >= cx) | (y_[body] >= cy) << 1 | (z_[body] >= cz) << 2;
+    };
+    for (int i = begin; i < begin + count; ++i)
+      ++counts[octant(order_[i])];
+    int starts[8];
+    for (int o = 0, pos = begin; o < 8; ++o) {
+      starts[o] = pos;
+      pos += counts[o];
+    }
+    int fill[8];
+    std::copy(starts, starts + 8, fill);
+    for (int i = begin; i < begin + count; ++i)
+      scratch_[fill[octant(order_[i])]++] = order_[i];
+    std::copy(scratch_.begin() + begin, scratch_.begin() + begin + count, order_.begin() + begin);
+
+    int firstChild = (int)nodes_.size();
+    int numChildren = 0;
+    for (int o = 0; o < 8; ++o) {
+      if (counts[o]) {
+        nodes_.push_back(Node{0, 0, 0, 0, half, -1, 0, starts[o], counts[o]});
+        ++numChildren;
+      }
+    }
+    nodes_[index].firstChild = firstChild;
+    nodes_[index].numChildren = numChildren;
+
+    double quarter = 0.5 * half;
+    double mx = 0, my = 0, mz = 0, m = 0;
+    for (int o = 0, child = firstChild; o < 8; ++o) {
+      if (!counts[o])
+        continue;
+      buildNode(
+          child,
+          cx + (o & 1 ? quarter : -quarter),
+          cy + (o & 2 ? quarter : -quarter),
+          cz + (o & 4 ? quarter : -quarter),
+          quarter,
+          depth + 1);
+      // nodes_ may have been reallocated by the recursion.
+      const Node &c = nodes_[child];
+      mx += c.x * c.mass;
+      my += c.y * c.mass;
+      mz += c.z * c.mass;
+      m += c.mass;
+      ++child;
+    }
+    Node &node = nodes_[index];
+    node.mass = m;
+    node.x = m > 0 ? mx / m : cx;
+    node.y = m > 0 ? my / m : cy;
+    node.z = m > 0 ? mz / m : cz;
+    return;
+  }
+
+  double mx = 0, my = 0, mz = 0, m = 0;
+  for (int i = begin; i < begin + count; ++i) {
+    int body = order_[i];
+    mx += x_[body] * mass_[body];
+    my += y_[body] * mass_[body];
+    mz += z_[body] * mass_[body];
+    m += mass_[body];
+  }
+  Node &node = nodes_[index];
+  node.mass = m;
+  node.x = m > 0 ? mx / m : cx;
+  node.y = m > 0 ? my / m : cy;
+  node.z = m > 0 ? mz / m : cz;
+}
+
+void Octree::accumulate(
+    double px,
+    double py,
+    double pz,
+    double theta,
+    double *ax,
+    double *ay,
+    double *az,
+    double *phi) const {
+  double theta2 = theta * theta;
+  double sumX = 0, sumY = 0, sumZ = 0, sumPhi = 0;
+  // Every open node pushes at most 8 children.
+  int stack[8 * MAX_DEPTH + 8];
+  int top = 0;
+  stack[top++] = 0;
+  while (top) {
+    const Node &node = nodes_[stack[--top]];
+    if (node.firstChild >= 0) {
+      double dx = node.x - px, dy = node.y - py, dz = node.z - pz;
+      double d2 = dx * dx + dy * dy + dz * dz;
+      if (node.size * node.size < theta2 * d2) {
+        double d = std::sqrt(d2);
+        double f = node.mass / (d2 * d);
+        sumX += dx * f;
+        sumY += dy * f;
+        sumZ += dz * f;
+        sumPhi -= node.mass / d;
+      } else {
+        for (int c = 0; c < node.numChildren; ++c)
+          stack[top++] = node.firstChild + c;
+      }
+      continue;
+    }
+    for (int i = node.begin; i < node.begin + node.count; ++i) {
+      const Body &b = sorted_[i];
+      double dx = b.x - px, dy = b.y - py, dz = b.z - pz;
+      double d2 = dx * dx + dy * dy + dz * dz;
+      // Skips the body at (px, py, pz) itself, and any other at the same
+      // position, whose force would be infinite.
+      if (d2 == 0)
+        continue;
+      double d = std::sqrt(d2);
+      double f = b.mass / (d2 * d);
+      sumX += dx * f;
+      sumY += dy * f;
+      sumZ += dz * f;
+      sumPhi -= b.mass / d;
+    }
+  }
+  *ax += sumX;
+  *ay += sumY;
+  *az += sumZ;
+  *phi += sumPhi;
+}
+
+} // namespace
+
+struct NBodySim {
+  int n;
+  int mode = NBODY_DIRECT;
+  double theta = 0.5;
+  std::vector<double> x, y, z, vx, vy, vz, mass;
+  /// Acceleration and potential of every body, from the last force pass.
+  std::vector<double> ax, ay, az, phi;
+  WorkerPool pool;
+  Octree tree;
+
+  /// The energy to measure the drift against, from the first step.
+  double energy0 = 0;
+  bool haveEnergy0 = false;
+  double drift = 0;
+  double stepMs = 0;
+  char description[128];
+
+  NBodySim(const double *state, int n, unsigned threads)
+      : n(n),
+        x(state + NBODY_X * n, state + NBODY_X * n + n),
+        y(state + NBODY_Y * n, state + NBODY_Y * n + n),
+        z(state + NBODY_Z * n, state + NBODY_Z * n + n),
+        vx(state + NBODY_VX * n, state + NBODY_VX * n + n),
+        vy(state + NBODY_VY * n, state + NBODY_VY * n + n),
+        vz(state + NBODY_VZ * n, state + NBODY_VZ * n + n),
+        mass(state + NBODY_MASS * n, state + NBODY_MASS * n + n),
+        ax(n),
+        ay(n),
+        az(n),
+        phi(n),
+        pool(threads) {}
+
+  /// Fill ax, ay, az and phi from the current positions.
+  void computeForces();
+  /// The energy, from the potential left by the last computeForces(), which
+  /// must have been called since the positions changed.
+  double energyFromForces();
+  double energy() {
+    computeForces();
+    return energyFromForces();
+  }
+};
+
+void NBodySim::computeForces() {
+  if (mode == NBODY_BARNES_HUT) {
+    tree.build(x.data(), y.data(), z.data(), mass.data(), n);
+    pool.parallelFor(n, [this](int begin, int end) {
+      for (int k = begin; k < end; ++k) {
+        int i = tree.body(k);
+        ax[i] = ay[i] = az[i] = phi[i] = 0;
+        tree.accumulate(x[i], y[i], z[i], theta, &ax[i], &ay[i], &az[i], &phi[i]);
+      }
+    });
+    return;
+  }
+
+  // Every body sums over all the others, so the pairs are visited twice, but
+  // no two threads write the same body.
+  pool.parallelFor(n, [this](int begin, int end) {
+    for (int i = begin; i < end; ++i) {
+      double xi = x[i], yi = y[i], zi = z[i];
+      double sumX = 0, sumY = 0, sumZ = 0, sumPhi = 0;
+      for (int j = 0; j < n; ++j) {
+        double dx = x[j] - xi, dy = y[j] - yi, dz = z[j] - zi;
+        double d2 = dx * dx + dy * dy + dz * dz;
+        // Skips body i itself, and any body at the same position, whose force
+        // would be infinite.
+        if (d2 == 0)
+          continue;
+        double d = std::sqrt(d2);
+        double f = mass[j] / (d2 * d);
+        sumX += dx * f;
+        sumY += dy * f;
+        sumZ += dz * f;
+        sumPhi -= mass[j] / d;
+      }
+      ax[i] = sumX;
+      ay[i] = sumY;
+      az[i] = sumZ;
+      phi[i] = sumPhi;
+    }
+  });
+}
+
+double NBodySim::energyFromForces() {
+  // Sum per chunk and then in order, so the result doesn't depend on the
+  // scheduling.
+  std::vector<double> partial((n + WorkerPool::CHUNK - 1) / WorkerPool::CHUNK);
+  pool.parallelFor(n, [this, &partial](int begin, int end) {
+    double e = 0;
+    for (int i = begin; i < end; ++i)
+      e += mass[i] * (0.5 * (vx[i] * vx[i] + vy[i] * vy[i] + vz[i] * vz[i]) + 0.5 * phi[i]);
+    partial[begin / WorkerPool::CHUNK] = e;
+  });
+  double e = 0;
+  for (double p : partial)
+    e += p;
+  return e;
+}
+
+extern "C" NBodySim *nbody_sim_create(const double *state, int n, int threads) {
+  if (n < 1)
+    return nullptr;
+  if (threads <= 0)
+    threads = (int)std::max(1u, std::thread::hardware_concurrency());
+  threads = std::min(threads, (int)NBODY_MAX_THREADS);
+  return new NBodySim(state, n, (unsigned)threads);
+}
+
+extern "C" void nbody_sim_destroy(NBodySim *sim) {
+  delete sim;
+}
+
+extern "C" void nbody_sim_set_mode(NBodySim *sim, int mode, double theta) {
+  sim->mode = mode;
+  sim->theta = theta;
+  sim->haveEnergy0 = false;
+  sim->drift = 0;
+}
+
+extern "C" void nbody_sim_step(NBodySim *sim, double dt, int steps) {
+  int n = sim->n;
+  for (int step = 0; step < steps; ++step) {
+    double start = nbody_now();
+    // Kick with the forces at the current positions, then drift, like
+    // nbody_advance().
+    sim->computeForces();
+    // The velocities haven't been kicked yet, so this is the energy of the
+    // current state.
+    double e = sim->energyFromForces();
+    if (!sim->haveEnergy0) {
+      sim->energy0 = e;
+      sim->haveEnergy0 = true;
+    }
+    sim->drift = (e - sim->energy0) / std::fabs(sim->energy0);
+    sim->pool.parallelFor(n, [sim, dt](int begin, int end) {
+      for (int i = begin; i < end; ++i) {
+        sim->vx[i] += dt * sim->ax[i];
+        sim->vy[i] += dt * sim->ay[i];
+        sim->vz[i] += dt * sim->az[i];
+        sim->x[i] += dt * sim->vx[i];
+        sim->y[i] += dt * sim->vy[i];
+        sim->z[i] += dt * sim->vz[i];
+      }
+    });
+    sim->stepMs = 1000 * (nbody_now() - start);
+  }
+}
+
+extern "C" double nbody_sim_energy(NBodySim *sim) {
+  return sim->energy();
+}
+
+extern "C" double nbody_sim_energy_drift(NBodySim *sim) {
+  return sim->drift;
+}
+
+extern "C" void nbody_sim_positions(NBodySim *sim, double *x, double *y) {
+  std::copy(sim->x.begin(), sim->x.end(), x);
+  std::copy(sim->y.begin(), sim->y.end(), y);
+}
+
+extern "C" const char *nbody_sim_describe(NBodySim *sim) {
+  if (sim->mode == NBODY_BARNES_HUT) {
+    snprintf(
+        sim->description,
+        sizeof(sim->description),
+        "%d bodies, Barnes-Hut theta=%.2f, %u threads, %.1f ms/step, energy drift %.3g",
+        sim->n,
+        sim->theta,
+        sim->pool.threads(),
+        sim->stepMs,
+        sim->drift);
+  } else {
+    snprintf(
+        sim->description,
+        sizeof(sim->description),
+        "%d bodies, direct, %u threads, %.1f ms/step, energy drift %.3g",
+        sim->n,
+        sim->pool.threads(),
+        sim->stepMs,
+        sim->drift);
+  }
+  return sim->description;
+}
+
+extern "C" double nbody_now() {
+  return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+extern "C" void nbody_bench_header() {
+  printf(
+      "%-10s %7s %9s %9s %14s %12s\n",
+      "engine",
+      "n",
+      "steps",
+      "seconds",
+      "interactions/s",
+      "energy drift");
+}
+
+extern "C" void
+nbody_bench_report(const char *engine, int n, int steps, double seconds, double e0, double e1) {
+  double interactions = 0.5 * n * (n - 1) * (double)steps;
+  printf(
+      "%-10s %7d %9d %9.3f %14.4g %12.3g\n",
+      engine,
+      n,
+      steps,
+      seconds,
+      seconds > 0 ? interactions / seconds : 0,
+      e0 != 0 ? (e1 - e0) / std::fabs(e0) : 0);
+  fflush(stdout);
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// The native twin of the structure-of-arrays N-body engine in nbody.js.
+//
+// The state of n bodies is one array of NBODY_COMPONENTS * n doubles: all the
+// x coordinates, then all the y coordinates, and so on, in the order of the
+// enum. nbody.js maps the same memory with Float64Array views, so both
+// engines can run on the same state.
+
+enum {
+  NBODY_X,
+  NBODY_Y,
+  NBODY_Z,
+  NBODY_VX,
+  NBODY_VY,
+  NBODY_VZ,
+  NBODY_MASS,
+  NBODY_COMPONENTS,
+};
+
+/// Advance the system by \p steps steps of \p dt with the direct O(n^2) sum,
+/// doing the same arithmetic as NBodySoA.advance() in nbody.js.
+void nbody_advance(double *state, int n, double dt, int steps);
+/// The total (kinetic plus potential) energy of the system.
+double nbody_energy(const double *state, int n);
+
+// A native simulation for large body counts, from 10k to 1M. It owns a copy of
+// the state and advances it with the same kick-drift scheme as
+// nbody_advance(), computing the accelerations on a pool of worker threads,
+// either by direct summation over all pairs or with a Barnes-Hut octree.
+
+enum {
+  /// Exact O(n^2) summation, each body on one worker.
+  NBODY_DIRECT,
+  /// O(n log n) Barnes-Hut approximation: a cell of size s at distance d from
+  /// a body acts as a point mass if s / d < theta.
+  NBODY_BARNES_HUT,
+};
+
+/// Most worker threads of a simulation; larger counts are clamped to it.
+enum { NBODY_MAX_THREADS = 256 };
+
+typedef struct NBodySim NBodySim;
+
+/// Copy the n bodies in \p state (laid out as above) into a new simulation
+/// using \p threads threads (at most NBODY_MAX_THREADS), or all hardware
+/// threads if 0. Returns NULL if \p n < 1. Bodies at the same position exert
+/// no force on each other.
+NBodySim *nbody_sim_create(const double *state, int n, int threads);
+void nbody_sim_destroy(NBodySim *sim);
+/// Select the force computation and restart the energy drift measurement.
+void nbody_sim_set_mode(NBodySim *sim, int mode, double theta);
+/// Advance by \p steps steps of \p dt.
+void nbody_sim_step(NBodySim *sim, double dt, int steps);
+/// The total energy, computed with the current mode (so approximated by the
+/// tree in Barnes-Hut mode).
+double nbody_sim_energy(NBodySim *sim);
+/// (energy before the last step - energy before the first step since the mode
+/// was set) / |energy before that first step|. Every step gets the potential
+/// from the force pass it already does, so measuring it costs one O(n) sum and
+/// no extra force pass.
+double nbody_sim_energy_drift(NBodySim *sim);
+/// Copy the x and y coordinates of the bodies to \p x and \p y.
+void nbody_sim_positions(NBodySim *sim, double *x, double *y);
+/// One line describing the mode, thread count, step time and energy drift,
+/// valid until the next call.
+const char *nbody_sim_describe(NBodySim *sim);
+
+/// Monotonic time in seconds, for the benchmark.
+double nbody_now(void);
+/// Print the header of the benchmark table.
+void nbody_bench_header(void);
+/// Print one row of the benchmark table: \p steps steps of \p n bodies took
+/// \p seconds, and the energy went from \p e0 to \p e1.
+void nbody_bench_report(const char *engine, int n, int steps, double seconds, double e0, double e1);
+
+#ifdef __cplusplus
+}
+#endif
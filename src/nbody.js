@@ -32,15 +32,18 @@ class Body {
   }
 }
 
-/// Return the advance() function.
-function nbodyRunner(): (number => Body[]) {
+const NBODY_SOLAR_MASS: number = 4 * Math.PI * Math.PI;
+/// The number of bodies that aren't asteroids.
+const NBODY_PLANETS = 5;
+
+/// The Sun and the four outer planets, at rest relative to the Sun.
+function nbodyPlanets(): Body[] {
   /* The Computer Language Benchmarks Game
    https://salsa.debian.org/benchmarksgame-team/benchmarksgame/
    contributed by Isaac Gouy
    modified by Andrey Filatkin */
 
-  const PI: number = Math.PI;
-  const SOLAR_MASS: number = 4 * PI * PI;
+  const SOLAR_MASS: number = NBODY_SOLAR_MASS;
   const DAYS_PER_YEAR = 365.24;
 
   function Jupiter(): Body {
@@ -103,27 +106,19 @@ function nbodyRunner(): (number => Body[]) {
     return new Body("Sun", IM_COL32(255, 255, 0, 255), 0.0, 0.0, 0.0, 0.0, 0.0, 0.0, SOLAR_MASS);
   }
 
-  const bodies: Body[] = [Sun(), Jupiter(), Saturn(), Uranus(), Neptune()];
-
-  function offsetMomentum(): void {
-    let px = 0;
-    let py = 0;
-    let pz = 0;
-    const size: number = bodies.length;
-    for (let i = 0; i < size; i++) {
-      const body: Body = bodies[i];
-      const mass: number = body.mass;
-      px += body.vx * mass;
-      py += body.vy * mass;
-      pz += body.vz * mass;
-    }
+  return [Sun(), Jupiter(), Saturn(), Uranus(), Neptune()];
+}
 
-    const body: Body = bodies[0];
-    body.vx = -px / SOLAR_MASS;
-    body.vy = -py / SOLAR_MASS;
-    body.vz = -pz / SOLAR_MASS;
-  }
+/// The bodies of new NBodySoA(n) as Body objects.
+function nbodyInitialBodies(n: number): Body[] {
+  const soa = new NBodySoA(n);
+  const bodies = soa.toBodies();
+  soa.dispose();
+  return bodies;
+}
 
+/// Return the advance() function for \p bodies.
+function nbodyRunner(bodies: Body[]): (number => Body[]) {
   /// Return the bodies after each step.
   function advance(dt: number): Body[] {
     const size: number = bodies.length;
@@ -167,31 +162,311 @@ function nbodyRunner(): (number => Body[]) {
     return bodies;
   }
 
-  function energy(): number {
-    let e = 0;
-    const size: number = bodies.length;
+  return advance;
+}
 
-    for (let i = 0; i < size; i++) {
-      const bodyi: Body = bodies[i];
+/// The total (kinetic plus potential) energy of \p bodies.
+function nbodyEnergy(bodies: Body[]): number {
+  let e = 0;
+  const size: number = bodies.length;
 
-      e +=
-        0.5 *
-        bodyi.mass *
-        (bodyi.vx * bodyi.vx + bodyi.vy * bodyi.vy + bodyi.vz * bodyi.vz);
+  for (let i = 0; i < size; i++) {
+    const bodyi: Body = bodies[i];
 
-      for (let j = i + 1; j < size; j++) {
-        const bodyj: Body = bodies[j];
-        const dx: number = bodyi.x - bodyj.x;
-        const dy: number = bodyi.y - bodyj.y;
-        const dz: number = bodyi.z - bodyj.z;
+    e +=
+      0.5 *
+      bodyi.mass *
+      (bodyi.vx * bodyi.vx + bodyi.vy * bodyi.vy + bodyi.vz * bodyi.vz);
+
+    for (let j = i + 1; j < size; j++) {
+      const bodyj: Body = bodies[j];
+      const dx: number = bodyi.x - bodyj.x;
+      const dy: number = bodyi.y - bodyj.y;
+      const dz: number = bodyi.z - bodyj.z;
+
+      const distance: number = Math.sqrt(dx * dx + dy * dy + dz * dz);
+      e -= (bodyi.mass * bodyj.mass) / distance;
+    }
+  }
+  return e;
+}
+
+// The native twin, see nbody.h.
+const _nbody_advance = $SHBuiltin.extern_c({include: "nbody.h"}, function nbody_advance(state: c_ptr, n: c_int, dt: c_double, steps: c_int): void {
+});
+const _nbody_energy = $SHBuiltin.extern_c({include: "nbody.h"}, function nbody_energy(state: c_ptr, n: c_int): c_double {
+    throw 0;
+});
+const _nbody_now = $SHBuiltin.extern_c({include: "nbody.h"}, function nbody_now(): c_double {
+    throw 0;
+});
+const _nbody_bench_header = $SHBuiltin.extern_c({include: "nbody.h"}, function nbody_bench_header(): void {
+});
+const _nbody_bench_report = $SHBuiltin.extern_c({include: "nbody.h"}, function nbody_bench_report(engine: c_ptr, n: c_int, steps: c_int, seconds: c_double, e0: c_double, e1: c_double): void {
+});
+const _nbody_sim_create = $SHBuiltin.extern_c({include: "nbody.h"}, function nbody_sim_create(state: c_ptr, n: c_int, threads: c_int): c_ptr {
+    throw 0;
+});
+const _nbody_sim_destroy = $SHBuiltin.extern_c({include: "nbody.h"}, function nbody_sim_destroy(sim: c_ptr): void {
+});
+const _nbody_sim_set_mode = $SHBuiltin.extern_c({include: "nbody.h"}, function nbody_sim_set_mode(sim: c_ptr, mode: c_int, theta: c_double): void {
+});
+const _nbody_sim_step = $SHBuiltin.extern_c({include: "nbody.h"}, function nbody_sim_step(sim: c_ptr, dt: c_double, steps: c_int): void {
+});
+const _nbody_sim_energy = $SHBuiltin.extern_c({include: "nbody.h"}, function nbody_sim_energy(sim: c_ptr): c_double {
+    throw 0;
+});
+const _nbody_sim_energy_drift = $SHBuiltin.extern_c({include: "nbody.h"}, function nbody_sim_energy_drift(sim: c_ptr): c_double {
+    throw 0;
+});
+const _nbody_sim_positions = $SHBuiltin.extern_c({include: "nbody.h"}, function nbody_sim_positions(sim: c_ptr, x: c_ptr, y: c_ptr): void {
+});
+const _nbody_sim_describe = $SHBuiltin.extern_c({include: "nbody.h"}, function nbody_sim_describe(sim: c_ptr): c_ptr {
+    throw 0;
+});
+
+// The layout of the native state, in arrays of n doubles.
+const NBODY_X = 0;
+const NBODY_Y = 1;
+const NBODY_Z = 2;
+const NBODY_VX = 3;
+const NBODY_VY = 4;
+const NBODY_VZ = 5;
+const NBODY_MASS = 6;
+const NBODY_COMPONENTS = 7;
+
+/// The Sun, the four outer planets and, for \p n > 5, n - 5 asteroids of
+/// negligible mass on circular orbits between 2 and 3.5 AU, with the total
+/// momentum offset to zero, in structure-of-arrays form: one Float64Array per
+/// component, all mapped over one native block in the layout of nbody.h, so the
+/// native engines can advance the same state. The asteroids are placed by a
+/// fixed sequence, so every engine starts from the same state.
+class NBodySoA {
+  n: number;
+  state: c_ptr;
+  x: Float64Array;
+  y: Float64Array;
+  z: Float64Array;
+  vx: Float64Array;
+  vy: Float64Array;
+  vz: Float64Array;
+  mass: Float64Array;
+
+  constructor(n: number) {
+    this.n = n;
+    this.state = nativeAlloc(NBODY_COMPONENTS * n * 8);
+    this.x = nativeFloat64Array(_sh_ptr_add(this.state, NBODY_X * n * 8), n);
+    this.y = nativeFloat64Array(_sh_ptr_add(this.state, NBODY_Y * n * 8), n);
+    this.z = nativeFloat64Array(_sh_ptr_add(this.state, NBODY_Z * n * 8), n);
+    this.vx = nativeFloat64Array(_sh_ptr_add(this.state, NBODY_VX * n * 8), n);
+    this.vy = nativeFloat64Array(_sh_ptr_add(this.state, NBODY_VY * n * 8), n);
+    this.vz = nativeFloat64Array(_sh_ptr_add(this.state, NBODY_VZ * n * 8), n);
+    this.mass = nativeFloat64Array(_sh_ptr_add(this.state, NBODY_MASS * n * 8), n);
+
+    const planets = nbodyPlanets();
+    for (let i = 0; i < n && i < NBODY_PLANETS; ++i) {
+      const body = planets[i];
+      this.x[i] = body.x;
+      this.y[i] = body.y;
+      this.z[i] = body.z;
+      this.vx[i] = body.vx;
+      this.vy[i] = body.vy;
+      this.vz[i] = body.vz;
+      this.mass[i] = body.mass;
+    }
+
+    // Low-discrepancy sequences for the radius, angle and height of the orbits.
+    function frac(v: number): number {
+      return v - Math.floor(v);
+    }
+    for (let i = NBODY_PLANETS, k = 0; i < n; ++i, ++k) {
+      const r = 2.0 + 1.5 * frac(k * 0.6180339887498949);
+      const angle = 2 * Math.PI * frac(k * 0.7548776662466927);
+      const speed = Math.sqrt(NBODY_SOLAR_MASS / r);
+      this.x[i] = r * Math.cos(angle);
+      this.y[i] = r * Math.sin(angle);
+      this.z[i] = 0.05 * (frac(k * 0.5698402909980532) - 0.5);
+      this.vx[i] = -speed * Math.sin(angle);
+      this.vy[i] = speed * Math.cos(angle);
+      this.vz[i] = 0.0;
+      this.mass[i] = 1e-12 * NBODY_SOLAR_MASS;
+    }
+
+    // Offset the momentum of the Sun.
+    let px = 0;
+    let py = 0;
+    let pz = 0;
+    for (let i = 0; i < n; i++) {
+      px += this.vx[i] * this.mass[i];
+      py += this.vy[i] * this.mass[i];
+      pz += this.vz[i] * this.mass[i];
+    }
+    this.vx[0] = -px / NBODY_SOLAR_MASS;
+    this.vy[0] = -py / NBODY_SOLAR_MASS;
+    this.vz[0] = -pz / NBODY_SOLAR_MASS;
+  }
+
+  /// A copy of the state as Body objects, for the object engine.
+  toBodies(): Body[] {
+    const planets = nbodyPlanets();
+    const asteroidColor = IM_COL32(160, 160, 160, 255);
+    const bodies: Body[] = [];
+    for (let i = 0; i < this.n; ++i) {
+      bodies.push(new Body(
+        i < NBODY_PLANETS ? planets[i].name : "Asteroid",
+        i < NBODY_PLANETS ? planets[i].color : asteroidColor,
+        this.x[i],
+        this.y[i],
+        this.z[i],
+        this.vx[i],
+        this.vy[i],
+        this.vz[i],
+        this.mass[i]
+      ));
+    }
+    return bodies;
+  }
+
+  /// The same arithmetic as the advance() of nbodyRunner().
+  advance(dt: number): void {
+    const n = this.n;
+    const x = this.x, y = this.y, z = this.z;
+    const vx = this.vx, vy = this.vy, vz = this.vz;
+    const mass = this.mass;
 
-        const distance: number = Math.sqrt(dx * dx + dy * dy + dz * dz);
-        e -= (bodyi.mass * bodyj.mass) / distance;
+    for (let i = 0; i < n; i++) {
+      const xi = x[i], yi = y[i], zi = z[i];
+      let vxi = vx[i];
+      let vyi = vy[i];
+      let vzi = vz[i];
+      const massi = mass[i];
+      for (let j = i + 1; j < n; j++) {
+        const dx = xi - x[j];
+        const dy = yi - y[j];
+        const dz = zi - z[j];
+
+        const d2 = dx * dx + dy * dy + dz * dz;
+        const mag = dt / (d2 * Math.sqrt(d2));
+
+        const massj = mass[j];
+        vxi -= dx * massj * mag;
+        vyi -= dy * massj * mag;
+        vzi -= dz * massj * mag;
+
+        vx[j] += dx * massi * mag;
+        vy[j] += dy * massi * mag;
+        vz[j] += dz * massi * mag;
       }
+      vx[i] = vxi;
+      vy[i] = vyi;
+      vz[i] = vzi;
+    }
+
+    for (let i = 0; i < n; i++) {
+      x[i] += dt * vx[i];
+      y[i] += dt * vy[i];
+      z[i] += dt * vz[i];
     }
-    return e;
   }
 
-  offsetMomentum();
-  return advance;
+  /// Advance with the native twin instead.
+  advanceNative(dt: number, steps: number): void {
+    _nbody_advance(this.state, this.n, dt, steps);
+  }
+
+  energy(): number {
+    return _nbody_energy(this.state, this.n);
+  }
+
+  /// Free the native state. The views must not be used afterwards.
+  dispose(): void {
+    nativeFree(this.state);
+  }
+}
+
+// Force computations of the native simulation.
+const NBODY_DIRECT = 0;
+const NBODY_BARNES_HUT = 1;
+// Most worker threads of the native simulation, see nbody.h.
+const NBODY_MAX_THREADS = 256;
+
+/// Body counts of the benchmark.
+const NBODY_BENCH_SIZES = [5, 100, 1000, 10000];
+/// Interactions per run, so that every size runs for a similar time.
+const NBODY_BENCH_INTERACTIONS = 5e7;
+
+/// Body counts of the native simulation benchmark, and the largest that is run
+/// with the direct sum too.
+const NBODY_SIM_BENCH_SIZES = [10000, 100000, 1000000];
+const NBODY_SIM_BENCH_MAX_DIRECT = 100000;
+/// Pairwise interactions per run, by mode, and the fewest steps per run, so
+/// that the energy drift covers more than a single step.
+const NBODY_SIM_BENCH_INTERACTIONS = [5e8, 5e9];
+const NBODY_SIM_BENCH_MIN_STEPS = 10;
+const NBODY_SIM_BENCH_THETA = 0.5;
+
+/// Run the same simulation with the object engine, the typed-array engine and
+/// the native twin for every size, then with the multithreaded native
+/// simulation for larger sizes, and print interactions per second and the
+/// relative energy drift of each.
+function nbodyBenchmark(): void {
+  const dt = 0.01;
+  _nbody_bench_header();
+  for (let k = 0; k < NBODY_BENCH_SIZES.length; ++k) {
+    const n = NBODY_BENCH_SIZES[k];
+    const steps = Math.max(2, Math.ceil(NBODY_BENCH_INTERACTIONS / (0.5 * n * (n - 1))));
+
+    const bodies = nbodyInitialBodies(n);
+    let e0 = nbodyEnergy(bodies);
+    const advance = nbodyRunner(bodies);
+    let start = _nbody_now();
+    for (let step = 0; step < steps; ++step)
+      advance(dt);
+    _nbody_bench_report(internAsciiz("objects"), n, steps, _nbody_now() - start, e0, nbodyEnergy(bodies));
+
+    const soa = new NBodySoA(n);
+    e0 = soa.energy();
+    start = _nbody_now();
+    for (let step = 0; step < steps; ++step)
+      soa.advance(dt);
+    _nbody_bench_report(internAsciiz("typed"), n, steps, _nbody_now() - start, e0, soa.energy());
+    soa.dispose();
+
+    const native = new NBodySoA(n);
+    e0 = native.energy();
+    start = _nbody_now();
+    native.advanceNative(dt, steps);
+    _nbody_bench_report(internAsciiz("native"), n, steps, _nbody_now() - start, e0, native.energy());
+    native.dispose();
+  }
+
+  // The native simulation on all hardware threads. Barnes-Hut counts the
+  // pairs that it approximates, so its interactions/s is the speed of a direct
+  // sum that would take as long.
+  for (let k = 0; k < NBODY_SIM_BENCH_SIZES.length; ++k) {
+    const n = NBODY_SIM_BENCH_SIZES[k];
+    const soa = new NBodySoA(n);
+    for (let mode = NBODY_DIRECT; mode <= NBODY_BARNES_HUT; ++mode) {
+      if (mode === NBODY_DIRECT && n > NBODY_SIM_BENCH_MAX_DIRECT)
+        continue;
+      const steps = Math.max(
+        NBODY_SIM_BENCH_MIN_STEPS,
+        Math.ceil(NBODY_SIM_BENCH_INTERACTIONS[mode] / (0.5 * n * (n - 1))));
+      const sim = _nbody_sim_create(soa.state, n, 0);
+      _nbody_sim_set_mode(sim, mode, NBODY_SIM_BENCH_THETA);
+      const e0 = _nbody_sim_energy(sim);
+      const start = _nbody_now();
+      _nbody_sim_step(sim, dt, steps);
+      const seconds = _nbody_now() - start;
+      _nbody_bench_report(
+        internAsciiz(mode === NBODY_DIRECT ? "direct-mt" : "barnes-hut"),
+        n,
+        steps,
+        seconds,
+        e0,
+        _nbody_sim_energy(sim));
+      _nbody_sim_destroy(sim);
+    }
+    soa.dispose();
+  }
 }
@@ -0,0 +1,295 @@
+#include "quad_renderer.h"
+
+#include <algorithm>
+
+// The shaders only scale the unit quad by the instance rectangle, map it to
+// clip space and tint the atlas texel.
+
+static const char s_vsGLSL330[] = R"(#version 330
+uniform vec4 vs_params[1];
+layout(location = 0) in vec2 corner;
+layout(location = 1) in vec4 inst_rect;
+layout(location = 2) in vec4 inst_uv;
+layout(location = 3) in vec4 inst_color;
+out vec2 uv;
+out vec4 color;
+void main() {
+  vec2 pos = inst_rect.xy + corner * inst_rect.zw;
+  gl_Position = vec4(pos * vs_params[0].xy + vs_params[0].zw, 0.5, 1.0);
+  uv = mix(inst_uv.xy, inst_uv.zw, corner);
+  color = inst_color;
+}
+)";
+
+static const char s_fsGLSL330[] = R"(#version 330
+uniform sampler2D tex_smp;
+in vec2 uv;
+in vec4 color;
+out vec4 frag_color;
+void main() {
+  frag_color = texture(tex_smp, uv) * color;
+}
+)";
+
+static const char s_vsMetal[] = R"(#include <metal_stdlib>
+using namespace metal;
+struct vs_params { float4 xform; };
+struct vs_in {
+  float2 corner [[attribute(0)]];
+  float4 inst_rect [[attribute(1)]];
+  float4 inst_uv [[attribute(2)]];
+  float4 inst_color [[attribute(3)]];
+};
+struct vs_out {
+  float4 pos [[position]];
+  float2 uv [[user(locn0)]];
+  float4 color [[user(locn1)]];
+};
+vertex vs_out main0(vs_in in [[stage_in]], constant vs_params& params [[buffer(0)]]) {
+  vs_out out;
+  float2 pos = in.inst_rect.xy + in.corner * in.inst_rect.zw;
+  out.pos = float4(pos * params.xform.xy + params.xform.zw, 0.5, 1.0);
+  out.uv = mix(in.inst_uv.xy, in.inst_uv.zw, in.corner);
+  out.color = in.inst_color;
+  return out;
+}
+)";
+
+static const char s_fsMetal[] = R"(#include <metal_stdlib>
+using namespace metal;
+struct fs_in {
+  float2 uv [[user(locn0)]];
+  float4 color [[user(locn1)]];
+};
+fragment float4 main0(
+    fs_in in [[stage_in]], texture2d<float> tex [[texture(0)]], sampler smp [[sampler(0)]]) {
+  return tex.sample(smp, in.uv) * in.color;
+}
+)";
+
+static const char s_vsHLSL[] = R"(
+cbuffer vs_params : register(b0) { float4 xform; };
+struct vs_in {
+  float2 corner : TEXCOORD0;
+  float4 inst_rect : TEXCOORD1;
+  float4 inst_uv : TEXCOORD2;
+  float4 inst_color : TEXCOORD3;
+};
+struct vs_out {
+  float2 uv : TEXCOORD0;
+  float4 color : TEXCOORD1;
+  float4 pos : SV_Position;
+};
+vs_out main(vs_in inp) {
+  vs_out outp;
+  float2 pos = inp.inst_rect.xy + inp.corner * inp.inst_rect.zw;
+  outp.pos = float4(pos * xform.xy + xform.zw, 0.5, 1.0);
+  outp.uv = lerp(inp.inst_uv.xy, inp.inst_uv.zw, inp.corner);
+  outp.color = inp.inst_color;
+  return outp;
+}
+)";
+
+static const char s_fsHLSL[] = R"(
+Texture2D<float4> tex : register(t0);
+SamplerState smp : register(s0);
+float4 main(float2 uv : TEXCOORD0, float4 color : TEXCOORD1) : SV_Target0 {
+  return tex.Sample(smp, uv) * color;
+}
+)";
+
+/// Padding around each atlas image, filled by repeating its edge texels, so
+/// that linear filtering at the edges doesn't pick up the neighbours.
+static const int ATLAS_PAD = 2;
+
+bool QuadRenderer::setup(size_t maxInstances, float virtualW, float virtualH) {
+  sg_shader_desc shd = {};
+  switch (sg_query_backend()) {
+    case SG_BACKEND_GLCORE33:
+      shd.vs.source = s_vsGLSL330;
+      shd.fs.source = s_fsGLSL330;
+      break;
+    case SG_BACKEND_METAL_MACOS:
+    case SG_BACKEND_METAL_IOS:
+    case SG_BACKEND_METAL_SIMULATOR:
+      shd.vs.source = s_vsMetal;
+      shd.fs.source = s_fsMetal;
+      shd.vs.entry = "main0";
+      shd.fs.entry = "main0";
+      break;
+    case SG_BACKEND_D3D11:
+      shd.vs.source = s_vsHLSL;
+      shd.fs.source = s_fsHLSL;
+      break;
+    case SG_BACKEND_DUMMY:
+      shd.vs.source = "";
+      shd.fs.source = "";
+      break;
+    default:
+      return false;
+  }
+
+  capacity_ = maxInstances;
+  virtualW_ = virtualW;
+  virtualH_ = virtualH;
+
+  static const char *const attrNames[] = {"corner", "inst_rect", "inst_uv", "inst_color"};
+  for (int i = 0; i < 4; ++i) {
+    shd.attrs[i].name = attrNames[i];
+    shd.attrs[i].sem_name = "TEXCOORD";
+    shd.attrs[i].sem_index = i;
+  }
+  shd.vs.uniform_blocks[0].size = sizeof(float) * 4;
+  shd.vs.uniform_blocks[0].uniforms[0] = {
+      .name = "vs_params", .type = SG_UNIFORMTYPE_FLOAT4, .array_count = 1};
+  shd.fs.images[0] = {.used = true};
+  shd.fs.samplers[0] = {.used = true};
+  shd.fs.image_sampler_pairs[0] = {
+      .used = true, .image_slot = 0, .sampler_slot = 0, .glsl_name = "tex_smp"};
+  shd.label = "quad-renderer-shader";
+  shader_ = sg_make_shader(&shd);
+
+  sg_pipeline_desc pip = {};
+  pip.shader = shader_;
+  pip.layout.buffers[1].step_func = SG_VERTEXSTEP_PER_INSTANCE;
+  pip.layout.buffers[1].stride = sizeof(QuadInstance);
+  pip.layout.attrs[0] = {.buffer_index = 0, .format = SG_VERTEXFORMAT_FLOAT2};
+  pip.layout.attrs[1] = {
+      .buffer_index = 1, .offset = offsetof(QuadInstance, x), .format = SG_VERTEXFORMAT_FLOAT4};
+  pip.layout.attrs[2] = {
+      .buffer_index = 1, .offset = offsetof(QuadInstance, u0), .format = SG_VERTEXFORMAT_FLOAT4};
+  pip.layout.attrs[3] = {
+      .buffer_index = 1,
+      .offset = offsetof(QuadInstance, color),
+      .format = SG_VERTEXFORMAT_UBYTE4N};
+  pip.index_type = SG_INDEXTYPE_UINT16;
+  pip.colors[0].blend = {
+      .enabled = true,
+      .src_factor_rgb = SG_BLENDFACTOR_SRC_ALPHA,
+      .dst_factor_rgb = SG_BLENDFACTOR_ONE_MINUS_SRC_ALPHA};
+  pip.label = "quad-renderer-pipeline";
+  pipeline_ = sg_make_pipeline(&pip);
+
+  static const float corners[] = {0, 0, 1, 0, 1, 1, 0, 1};
+  static const uint16_t indices[] = {0, 1, 2, 0, 2, 3};
+  quadVB_ = sg_make_buffer(sg_buffer_desc{.data = SG_RANGE(corners), .label = "quad-corners"});
+  quadIB_ = sg_make_buffer(sg_buffer_desc{
+      .type = SG_BUFFERTYPE_INDEXBUFFER, .data = SG_RANGE(indices), .label = "quad-indices"});
+  instanceVB_ = sg_make_buffer(sg_buffer_desc{
+      .size = std::max<size_t>(1, maxInstances) * sizeof(QuadInstance),
+      .usage = SG_USAGE_STREAM,
+      .label = "quad-instances"});
+  sampler_ = sg_make_sampler(sg_sampler_desc{
+      .min_filter = SG_FILTER_LINEAR,
+      .mag_filter = SG_FILTER_LINEAR,
+      .wrap_u = SG_WRAP_CLAMP_TO_EDGE,
+      .wrap_v = SG_WRAP_CLAMP_TO_EDGE});
+
+  instances_.reserve(maxInstances);
+  setAtlas(nullptr, 0);
+  return true;
+}
+
+void QuadRenderer::shutdown() {
+  sg_destroy_image(atlas_);
+  sg_destroy_sampler(sampler_);
+  sg_destroy_buffer(instanceVB_);
+  sg_destroy_buffer(quadIB_);
+  sg_destroy_buffer(quadVB_);
+  sg_destroy_pipeline(pipeline_);
+  sg_destroy_shader(shader_);
+  *this = QuadRenderer();
+}
+
+void QuadRenderer::setAtlas(const AtlasImage *images, int count) {
+  // The images are stacked vertically, followed by a white block for
+  // untextured rectangles.
+  const int whiteSize = 1;
+  int atlasW = whiteSize + 2 * ATLAS_PAD, atlasH = whiteSize + 2 * ATLAS_PAD;
+  for (int i = 0; i < count; ++i) {
+    atlasW = std::max(atlasW, images[i].w + 2 * ATLAS_PAD);
+    atlasH += images[i].h + 2 * ATLAS_PAD;
+  }
+
+  std::vector<uint32_t> pixels((size_t)atlasW * atlasH, 0);
+  sprites_.clear();
+  int top = 0;
+  auto place = [&](const uint32_t *src, int w, int h) {
+    // Copy with the edge texels repeated into the padding.
+    for (int y = -ATLAS_PAD; y < h + ATLAS_PAD; ++y) {
+      const uint32_t *row = src + (size_t)std::min(std::max(y, 0), h - 1) * w;
+      uint32_t *dst = &pixels[(size_t)(top + ATLAS_PAD + y) * atlasW];
+      for (int x = -ATLAS_PAD; x < w + ATLAS_PAD; ++x)
+        dst[x + ATLAS_PAD] = row[std::min(std::max(x, 0), w - 1)];
+    }
+    sprites_.push_back(ImVec4{
+        (float)ATLAS_PAD / atlasW,
+        (float)(top + ATLAS_PAD) / atlasH,
+        (float)(ATLAS_PAD + w) / atlasW,
+        (float)(top + ATLAS_PAD + h) / atlasH});
+    top += h + 2 * ATLAS_PAD;
+  };
+  for (int i = 0; i < count; ++i)
+    place((const uint32_t *)images[i].rgba, images[i].w, images[i].h);
+  const uint32_t whitePixel = 0xFFFFFFFF;
+  place(&whitePixel, whiteSize, whiteSize);
+  // Sample the middle of the white texel.
+  ImVec4 &w = sprites_.back();
+  w.x = w.z = (w.x + w.z) / 2;
+  w.y = w.w = (w.y + w.w) / 2;
+
+  sg_destroy_image(atlas_);
+  sg_image_desc desc = {};
+  desc.width = atlasW;
+  desc.height = atlasH;
+  desc.data.subimage[0][0] = {pixels.data(), pixels.size() * sizeof(uint32_t)};
+  desc.label = "quad-atlas";
+  atlas_ = sg_make_image(&desc);
+}
+
+void QuadRenderer::upload() {
+  uploaded_ = std::min(instances_.size(), capacity_);
+  if (uploaded_)
+    sg_update_buffer(instanceVB_, sg_range{instances_.data(), uploaded_ * sizeof(QuadInstance)});
+}
+
+void QuadRenderer::addToDrawList(ImDrawList *dl, ImVec2 org, ImVec2 size, float dpiScale) {
+  dpiScale_ = dpiScale;
+  viewX_ = org.x * dpiScale;
+  viewY_ = org.y * dpiScale;
+  viewW_ = size.x * dpiScale;
+  viewH_ = size.y * dpiScale;
+  ImDrawList_AddCallback(dl, drawCallback, this);
+}
+
+void QuadRenderer::drawCallback(const ImDrawList *, const ImDrawCmd *cmd) {
+  static_cast<QuadRenderer *>(cmd->UserCallbackData)->draw(cmd);
+}
+
+void QuadRenderer::draw(const ImDrawCmd *cmd) {
+  if (!uploaded_)
+    return;
+
+  sg_apply_viewportf(viewX_, viewY_, viewW_, viewH_, true);
+  const ImVec4 &clip = cmd->ClipRect;
+  sg_apply_scissor_rectf(
+      clip.x * dpiScale_,
+      clip.y * dpiScale_,
+      (clip.z - clip.x) * dpiScale_,
+      (clip.w - clip.y) * dpiScale_,
+      true);
+  sg_apply_pipeline(pipeline_);
+
+  sg_bindings bind = {};
+  bind.vertex_buffers[0] = quadVB_;
+  bind.vertex_buffers[1] = instanceVB_;
+  bind.index_buffer = quadIB_;
+  bind.fs.images[0] = atlas_;
+  bind.fs.samplers[0] = sampler_;
+  sg_apply_bindings(&bind);
+
+  // Map virtual units to clip space, with y pointing down.
+  const float xform[4] = {2 / virtualW_, -2 / virtualH_, -1, 1};
+  sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, SG_RANGE(xform));
+  sg_draw(0, 6, (int)uploaded_);
+}
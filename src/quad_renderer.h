@@ -0,0 +1,105 @@
+#pragma once
+
+#include "sokol_gfx.h"
+
+#ifndef CIMGUI_DEFINE_ENUMS_AND_STRUCTS
+#define CIMGUI_DEFINE_ENUMS_AND_STRUCTS
+#endif
+#include "cimgui.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// One textured, tinted rectangle, as uploaded to the GPU.
+struct QuadInstance {
+  /// Top-left corner and size, in virtual units.
+  float x, y, w, h;
+  /// Texture rectangle in the atlas.
+  float u0, v0, u1, v1;
+  /// RGBA8, as IM_COL32().
+  uint32_t color;
+};
+
+/// Draws large numbers of rectangles with a native sokol_gfx pipeline: one
+/// QuadInstance per rectangle in a stream buffer and a single instanced
+/// sg_draw() for all of them, instead of 4 ImGui vertices and 6 indices each.
+///
+/// All rectangles share one texture atlas, built once by setAtlas(). The draw
+/// is issued from an ImDrawList callback, so it lands in the right place in
+/// the ImGui window order and is clipped like the window's own contents.
+///
+/// A frame looks like: clear(), add() for every rectangle, upload() before
+/// the render pass, then addToDrawList() from inside the ImGui window.
+class QuadRenderer {
+ public:
+  /// An RGBA8 image to put in the atlas.
+  struct AtlasImage {
+    const unsigned char *rgba;
+    int w, h;
+  };
+  /// Index of a region of the atlas, as returned by setAtlas().
+  typedef int Sprite;
+
+  /// Create the GPU resources. \p virtualW and \p virtualH are the size of
+  /// the coordinate space used by add(), which is stretched over the area
+  /// given to addToDrawList(). Returns false if the current sokol_gfx backend
+  /// has no shader for this renderer.
+  bool setup(size_t maxInstances, float virtualW, float virtualH);
+  void shutdown();
+
+  /// Pack \p images into the atlas, replacing any previous one. Sprite i
+  /// refers to images[i]; the sprite returned by white() is a solid white
+  /// texel, for untextured rectangles.
+  void setAtlas(const AtlasImage *images, int count);
+  Sprite white() const {
+    return (Sprite)sprites_.size() - 1;
+  }
+
+  void clear() {
+    instances_.clear();
+  }
+  void add(Sprite sprite, float x, float y, float w, float h, uint32_t color) {
+    const ImVec4 &uv = sprites_[sprite];
+    instances_.push_back(QuadInstance{x, y, w, h, uv.x, uv.y, uv.z, uv.w, color});
+  }
+  size_t size() const {
+    return instances_.size();
+  }
+
+  /// Copy this frame's instances to the GPU. Must be called at most once per
+  /// frame, outside of a render pass. Instances beyond the capacity passed to
+  /// setup() are dropped.
+  void upload();
+  /// Queue the instanced draw into \p dl, covering the screen rectangle
+  /// \p org .. \p org + \p size (ImGui coordinates).
+  void addToDrawList(ImDrawList *dl, ImVec2 org, ImVec2 size, float dpiScale);
+
+  /// Number of instances drawn by the last upload().
+  size_t uploaded() const {
+    return uploaded_;
+  }
+
+ private:
+  size_t capacity_ = 0;
+  float virtualW_ = 1, virtualH_ = 1;
+  sg_shader shader_ = {};
+  sg_pipeline pipeline_ = {};
+  sg_buffer quadVB_ = {};
+  sg_buffer quadIB_ = {};
+  sg_buffer instanceVB_ = {};
+  sg_image atlas_ = {};
+  sg_sampler sampler_ = {};
+
+  /// UV rectangles (u0, v0, u1, v1) of the atlas regions.
+  std::vector<ImVec4> sprites_;
+  std::vector<QuadInstance> instances_;
+  size_t uploaded_ = 0;
+
+  /// Where to draw, saved by addToDrawList() for the callback, in framebuffer
+  /// pixels.
+  float viewX_ = 0, viewY_ = 0, viewW_ = 0, viewH_ = 0, dpiScale_ = 1;
+
+  static void drawCallback(const ImDrawList *dl, const ImDrawCmd *cmd);
+  void draw(const ImDrawCmd *cmd);
+};
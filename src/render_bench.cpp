@@ -0,0 +1,287 @@
+// Headless benchmark of the CPU cost of drawing the game layer. Runs on the
+// sokol_gfx dummy backend, so nothing reaches a GPU, but everything on the CPU
+// side happens as in the demo: ImGui frame, game draw, simgui_render() and the
+// sokol_gfx calls.
+//
+// Usage: render_bench [--frames=N] [--warmup=N] [--enemies=N] [--bullets=N]
+//                     [--explosions=N] [--path=batched|instanced|both]
+//                     [--upload=update|append]
+//
+// "batched" draws through SpriteBatch into the ImGui draw list, "instanced"
+// through QuadRenderer with one instanced draw. --upload selects how
+// simgui_render() uploads the UI geometry (the default of the dummy backend is
+// append).
+
+#include "game.h"
+#include "game_render.h"
+#include "sokol_gfx.h"
+#include "sokol_log.h"
+#include "sokol_time.h"
+
+#define SOKOL_IMGUI_NO_SOKOL_APP
+#include "sokol_imgui.h"
+#include "stb_image.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+extern "C" const unsigned char img_ship_png[];
+extern "C" const unsigned img_ship_png_size;
+extern "C" const unsigned char img_enemy_png[];
+extern "C" const unsigned img_enemy_png_size;
+extern "C" const unsigned char img_background_png[];
+extern "C" const unsigned img_background_png_size;
+
+static const int SCREEN_W = 1280, SCREEN_H = 960;
+
+struct Options {
+  long frames = 1000;
+  long warmup = 100;
+  long enemies = 200;
+  long bullets = 5000;
+  long explosions = 200;
+  bool batched = true;
+  bool instanced = true;
+  simgui_upload_mode_t upload = SIMGUI_UPLOADMODE_APPEND;
+};
+
+static bool parseLong(const char *arg, const char *name, long *out) {
+  size_t len = strlen(name);
+  if (strncmp(arg, name, len) != 0 || arg[len] != '=')
+    return false;
+  *out = strtol(arg + len + 1, nullptr, 0);
+  return true;
+}
+
+static void usage() {
+  fprintf(
+      stderr,
+      "usage: render_bench [--frames=N] [--warmup=N] [--enemies=N] [--bullets=N] "
+      "[--explosions=N] [--path=batched|instanced|both] [--upload=update|append]\n");
+  exit(1);
+}
+
+static Options parseOptions(int argc, char **argv) {
+  Options opt;
+  for (int i = 1; i < argc; ++i) {
+    if (parseLong(argv[i], "--frames", &opt.frames) ||
+        parseLong(argv[i], "--warmup", &opt.warmup) ||
+        parseLong(argv[i], "--enemies", &opt.enemies) ||
+        parseLong(argv[i], "--bullets", &opt.bullets) ||
+        parseLong(argv[i], "--explosions", &opt.explosions)) {
+      continue;
+    }
+    if (strncmp(argv[i], "--path=", 7) == 0) {
+      const char *path = argv[i] + 7;
+      opt.batched = strcmp(path, "batched") == 0 || strcmp(path, "both") == 0;
+      opt.instanced = strcmp(path, "instanced") == 0 || strcmp(path, "both") == 0;
+      if (opt.batched || opt.instanced)
+        continue;
+    }
+    if (strcmp(argv[i], "--upload=update") == 0 || strcmp(argv[i], "--upload=append") == 0) {
+      opt.upload = strcmp(argv[i], "--upload=update") == 0 ? SIMGUI_UPLOADMODE_UPDATE
+                                                            : SIMGUI_UPLOADMODE_APPEND;
+      continue;
+    }
+    usage();
+  }
+  if (opt.frames <= 0 || opt.warmup < 0 || opt.enemies < 0 || opt.bullets < 0 ||
+      opt.explosions < 0) {
+    usage();
+  }
+  return opt;
+}
+
+/// A decoded embedded image and its ImGui texture.
+struct BenchImage {
+  unsigned char *rgba;
+  int w, h;
+  sg_image image;
+  simgui_image_t simguiImage;
+};
+
+static BenchImage loadImage(const unsigned char *png, unsigned size, sg_sampler sampler) {
+  BenchImage img;
+  int n;
+  img.rgba = stbi_load_from_memory(png, (int)size, &img.w, &img.h, &n, 4);
+  if (!img.rgba)
+    abort();
+  sg_image_desc desc = {};
+  desc.width = img.w;
+  desc.height = img.h;
+  desc.data.subimage[0][0] = {img.rgba, (size_t)img.w * img.h * 4};
+  img.image = sg_make_image(&desc);
+  img.simguiImage = simgui_make_image(simgui_image_desc_t{img.image, sampler});
+  return img;
+}
+
+/// Keep the requested population alive, spread over the playfield.
+static void topUp(const Options &opt) {
+  while ((long)s_enemies.size() < opt.enemies)
+    createEnemy(mathRandom(ASSUMED_W), mathRandom(ASSUMED_H - 64));
+  while ((long)s_bullets.size() < opt.bullets)
+    createBullet(mathRandom(ASSUMED_W), mathRandom(ASSUMED_H));
+  while ((long)s_particles.size() < opt.explosions * 50 &&
+         s_particles.size() < s_particles.capacity()) {
+    createExplosion(mathRandom(ASSUMED_W), mathRandom(ASSUMED_H));
+  }
+}
+
+struct Result {
+  double nsPerFrame;
+  uint64_t p50, p99;
+  size_t drawCmds, vertices, instances;
+  /// Bytes appended by simgui_render() per frame, and ImGui upload buffer growths.
+  size_t uploadBytes;
+  int bufferGrows;
+};
+
+static BenchImage s_backgroundImg, s_shipImg, s_enemyImg;
+static SpriteBatch s_batch;
+static QuadRenderer s_quads;
+static GameSnapshot s_game;
+static GameRenderData s_gameRender;
+
+static Result run(const Options &opt, bool instanced) {
+  game_seed(1);
+  game_init(s_shipImg.w, s_shipImg.h, s_backgroundImg.w, GameHooks{});
+
+  std::vector<uint64_t> samples;
+  samples.reserve(opt.frames);
+  uint64_t totalNs = 0;
+  uint64_t totalUpload = 0;
+  Result res = {};
+  sg_pass_action passAction = {};
+
+  for (long frame = 0; frame < opt.warmup + opt.frames; ++frame) {
+    // The simulation isn't part of the measurement.
+    topUp(opt);
+    update_game_state(true);
+    game_snapshot(s_game);
+
+    uint64_t start = stm_now();
+    prepare_game_render(s_game, 0.5f, s_gameRender);
+    simgui_new_frame(simgui_frame_desc_t{
+        .width = SCREEN_W, .height = SCREEN_H, .delta_time = PHYS_DT, .dpi_scale = 1});
+    igSetNextWindowPos(ImVec2{0, 0}, ImGuiCond_Always, ImVec2{0, 0});
+    igSetNextWindowSize(ImVec2{SCREEN_W, SCREEN_H}, ImGuiCond_Always);
+    if (igBegin("Game", nullptr, 0)) {
+      ImVec2 org, size;
+      igGetCursorScreenPos(&org);
+      igGetContentRegionAvail(&size);
+      ImDrawList *dl = igGetWindowDrawList();
+      if (instanced) {
+        render_game_instanced(s_gameRender, s_quads, s_backgroundImg.w);
+        s_quads.upload();
+        s_quads.addToDrawList(dl, org, size, 1);
+      } else {
+        GameTextures textures = {
+            simgui_imtextureid(s_backgroundImg.simguiImage),
+            simgui_imtextureid(s_shipImg.simguiImage),
+            simgui_imtextureid(s_enemyImg.simguiImage)};
+        render_game_batched(s_gameRender, s_batch, dl, org, size, textures, s_backgroundImg.w);
+      }
+    }
+    igEnd();
+    sg_begin_default_pass(&passAction, SCREEN_W, SCREEN_H);
+    simgui_render();
+    sg_end_pass();
+    sg_commit();
+    uint64_t ns = (uint64_t)stm_ns(stm_since(start));
+
+    if (frame < opt.warmup)
+      continue;
+    samples.push_back(ns);
+    totalNs += ns;
+    totalUpload += simgui_query_frame_stats().total_bytes;
+  }
+
+  ImDrawData *drawData = igGetDrawData();
+  for (int i = 0; i < drawData->CmdListsCount; ++i)
+    res.drawCmds += drawData->CmdLists.Data[i]->CmdBuffer.Size;
+  res.vertices = drawData->TotalVtxCount;
+  res.instances = instanced ? s_quads.uploaded() : 0;
+  res.uploadBytes = totalUpload / opt.frames;
+  res.bufferGrows = simgui_query_frame_stats().num_buffer_grows;
+
+  std::sort(samples.begin(), samples.end());
+  auto percentile = [&samples](double p) {
+    return samples[std::min(samples.size() - 1, (size_t)(p * samples.size()))];
+  };
+  res.nsPerFrame = (double)totalNs / opt.frames;
+  res.p50 = percentile(0.50);
+  res.p99 = percentile(0.99);
+  return res;
+}
+
+int main(int argc, char **argv) {
+  Options opt = parseOptions(argc, argv);
+
+  stm_setup();
+  sg_desc desc = {};
+  desc.logger.func = slog_func;
+  sg_setup(&desc);
+  simgui_desc_t simguiDesc = {};
+  simguiDesc.logger.func = slog_func;
+  simguiDesc.upload_mode = opt.upload;
+  simgui_setup(&simguiDesc);
+
+  sg_sampler sampler = sg_make_sampler(sg_sampler_desc{
+      .min_filter = SG_FILTER_LINEAR,
+      .mag_filter = SG_FILTER_LINEAR,
+  });
+  s_backgroundImg = loadImage(img_background_png, img_background_png_size, sampler);
+  s_shipImg = loadImage(img_ship_png, img_ship_png_size, sampler);
+  s_enemyImg = loadImage(img_enemy_png, img_enemy_png_size, sampler);
+
+  if (!s_quads.setup(1 << 17, ASSUMED_W, ASSUMED_H))
+    abort();
+  QuadRenderer::AtlasImage atlas[SPRITE_COUNT];
+  atlas[SPRITE_BACKGROUND] = {s_backgroundImg.rgba, s_backgroundImg.w, s_backgroundImg.h};
+  atlas[SPRITE_SHIP] = {s_shipImg.rgba, s_shipImg.w, s_shipImg.h};
+  atlas[SPRITE_ENEMY] = {s_enemyImg.rgba, s_enemyImg.w, s_enemyImg.h};
+  s_quads.setAtlas(atlas, SPRITE_COUNT);
+
+  printf(
+      "frames=%ld enemies=%ld bullets=%ld explosions=%ld backend=dummy upload=%s\n",
+      opt.frames,
+      opt.enemies,
+      opt.bullets,
+      opt.explosions,
+      opt.upload == SIMGUI_UPLOADMODE_UPDATE ? "update" : "append");
+  printf(
+      "%-10s %12s %10s %10s %8s %10s %10s %12s %6s\n",
+      "path",
+      "ns/frame",
+      "p50",
+      "p99",
+      "cmds",
+      "vertices",
+      "instances",
+      "upload B",
+      "grows");
+  for (bool instanced : {false, true}) {
+    if (!(instanced ? opt.instanced : opt.batched))
+      continue;
+    Result res = run(opt, instanced);
+    printf(
+        "%-10s %12.1f %10llu %10llu %8zu %10zu %10zu %12zu %6d\n",
+        instanced ? "instanced" : "batched",
+        res.nsPerFrame,
+        (unsigned long long)res.p50,
+        (unsigned long long)res.p99,
+        res.drawCmds,
+        res.vertices,
+        res.instances,
+        res.uploadBytes,
+        res.bufferGrows);
+  }
+
+  s_quads.shutdown();
+  simgui_shutdown();
+  sg_shutdown();
+  return 0;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/// Small, fast, seedable PRNG (xoshiro128+) that produces the same sequence on
+/// every platform, unlike rand(). Not for anything security related.
+class Rng {
+  uint32_t s_[4];
+
+  static uint32_t rotl(uint32_t x, int k) {
+    return (x << k) | (x >> (32 - k));
+  }
+
+ public:
+  explicit Rng(uint64_t seed = 1) {
+    this->seed(seed);
+  }
+
+  /// Reset the state from \p seed, expanded with splitmix64 so that similar
+  /// seeds still give unrelated sequences.
+  void seed(uint64_t seed) {
+    for (int i = 0; i < 4; i += 2) {
+      uint64_t z = (seed += 0x9e3779b97f4a7c15);
+      z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+      z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+      z ^= z >> 31;
+      s_[i] = (uint32_t)z;
+      s_[i + 1] = (uint32_t)(z >> 32);
+    }
+  }
+
+  uint32_t next() {
+    uint32_t result = s_[0] + s_[3];
+    uint32_t t = s_[1] << 9;
+    s_[2] ^= s_[0];
+    s_[3] ^= s_[1];
+    s_[1] ^= s_[2];
+    s_[0] ^= s_[3];
+    s_[2] ^= t;
+    s_[3] = rotl(s_[3], 11);
+    return result;
+  }
+
+  /// A float in [0, 1) from the top 24 bits, which are the strongest ones of
+  /// xoshiro128+. Every possible value is exactly representable.
+  float nextFloat() {
+    return (float)(next() >> 8) * (1.0f / 16777216.0f);
+  }
+
+  /// Fill \p out with \p n values of nextFloat(), in the same order.
+  void fill(float *out, size_t n) {
+    // Work on a local copy of the state so that it stays in registers.
+    Rng r = *this;
+    for (size_t i = 0; i < n; ++i)
+      out[i] = r.nextFloat();
+    *this = r;
+  }
+};
@@ -10,9 +10,15 @@
 // Must be separate to avoid reordering.
 #include "sokol_debugtext.h"
 
+#include "frame_profiler.h"
+#include "input_latency.h"
+#include "native_view.h"
+#include "tmp_arena.h"
+
 #include <hermes/VM/static_h.h>
 #include <hermes/hermes.h>
 
+#include <optional>
 #include <vector>
 
 static sg_sampler s_sampler = {};
@@ -86,10 +92,141 @@ static std::vector<std::unique_ptr<Image>> s_images{};
 static SHRuntime *s_shRuntime = nullptr;
 static facebook::hermes::HermesRuntime *s_hermes = nullptr;
 
+/// A JS entry point (globalThis.on_frame etc.), held as a persistent handle
+/// so that calling it doesn't need a property lookup and a new jsi::Function
+/// every time. install() turns the global property into an accessor whose
+/// setter updates the handle, so JS can still reassign the callback.
+class JSCallback {
+ public:
+  explicit JSCallback(const char *name) : name_(name) {}
+
+  /// Take the current value of the global property and install the accessor.
+  void install(facebook::jsi::Runtime &rt);
+  /// Drop the handle. Must be called before the runtime is destroyed.
+  void reset() {
+    fn_.reset();
+  }
+
+  /// Call the callback. Throws a JSIException if it isn't a function.
+  template <typename... Args>
+  void call(facebook::jsi::Runtime &rt, Args &&...args) {
+    if (!fn_)
+      throw facebook::jsi::JSINativeException(std::string(name_) + " is not a function");
+    fn_->call(rt, std::forward<Args>(args)...);
+  }
+
+ private:
+  const char *const name_;
+  std::optional<facebook::jsi::Function> fn_;
+
+  void set(facebook::jsi::Runtime &rt, const facebook::jsi::Value &value) {
+    if (value.isObject() && value.getObject(rt).isFunction(rt))
+      fn_.emplace(value.getObject(rt).getFunction(rt));
+    else
+      fn_.reset();
+  }
+};
+
+void JSCallback::install(facebook::jsi::Runtime &rt) {
+  using namespace facebook::jsi;
+  Object global = rt.global();
+  set(rt, global.getProperty(rt, name_));
+
+  PropNameID propName = PropNameID::forAscii(rt, name_);
+  Object desc(rt);
+  desc.setProperty(rt, "configurable", true);
+  desc.setProperty(rt, "enumerable", true);
+  desc.setProperty(
+      rt,
+      "get",
+      Function::createFromHostFunction(
+          rt, propName, 0, [this](Runtime &rt, const Value &, const Value *, size_t) {
+            return fn_ ? Value(rt, *fn_) : Value::undefined();
+          }));
+  desc.setProperty(
+      rt,
+      "set",
+      Function::createFromHostFunction(
+          rt, propName, 1, [this](Runtime &rt, const Value &, const Value *args, size_t count) {
+            set(rt, count ? args[0] : Value::undefined());
+            return Value::undefined();
+          }));
+  global.getPropertyAsObject(rt, "Object")
+      .getPropertyAsFunction(rt, "defineProperty")
+      .call(rt, global, name_, desc);
+}
+
+static JSCallback s_onInit("on_init");
+static JSCallback s_onFrame("on_frame");
+static JSCallback s_onEvent("on_event");
+
 static bool s_started = false;
 static uint64_t s_start_time = 0;
-static uint64_t s_last_fps_time = 0;
-static double s_fps = 0;
+
+/// STAGE_SIM is timed by the JS code, inside STAGE_ON_FRAME.
+enum Stage {
+  STAGE_SIM,
+  STAGE_ON_FRAME,
+  STAGE_SIMGUI_RENDER,
+  STAGE_SDTX,
+  STAGE_COMMIT,
+  STAGE_COUNT,
+};
+static FrameProfiler s_profiler({"sim", "on_frame", "simgui", "sdtx", "commit"});
+/// Where F2 and $FRAME_TRACE write the Chrome trace.
+static const char *s_tracePath = "frame_trace.json";
+/// Key events until the first frame after them is committed: the JS game
+/// applies keys in on_event(), so the next frame is the first to show their
+/// effect. Sequence numbers are frames.
+static InputLatency s_latency;
+static uint32_t s_frameCount = 0;
+/// Where the latency histogram is written at exit.
+static const char *s_latencyPath = "input_latency.csv";
+
+extern "C" void frame_stage_begin(int stage) {
+  if (stage >= 0 && stage < STAGE_COUNT)
+    s_profiler.begin(stage);
+}
+extern "C" void frame_stage_end(int stage) {
+  if (stage >= 0 && stage < STAGE_COUNT)
+    s_profiler.end(stage);
+}
+
+/// Warn that environment variable \p name was ignored because its value isn't
+/// a number from \p min to \p max.
+static void warnBadEnv(const char *name, const char *value, double min, double max) {
+  char msg[160];
+  snprintf(msg, sizeof(msg), "%s=%s ignored, expected %g..%g", name, value, min, max);
+  slog_func("WARN", 2, 0, msg, __LINE__, __FILE__, nullptr);
+}
+
+/// The integer or floating point value of environment variable \p name, or
+/// \p defaultValue if it isn't set. A value that isn't a number, has trailing
+/// characters, or is outside \p min..\p max is ignored with a warning.
+extern "C" int getenv_int(const char *name, int defaultValue, int min, int max) {
+  const char *value = getenv(name);
+  if (!value)
+    return defaultValue;
+  char *end;
+  long n = strtol(value, &end, 0);
+  if (end == value || *end || n < min || n > max) {
+    warnBadEnv(name, value, min, max);
+    return defaultValue;
+  }
+  return (int)n;
+}
+extern "C" double getenv_double(const char *name, double defaultValue, double min, double max) {
+  const char *value = getenv(name);
+  if (!value)
+    return defaultValue;
+  char *end;
+  double d = strtod(value, &end);
+  if (end == value || *end || !(d >= min && d <= max)) {
+    warnBadEnv(name, value, min, max);
+    return defaultValue;
+  }
+  return d;
+}
 
 extern "C" int load_image(const char *path) {
   s_images.emplace_back(std::make_unique<Image>(path));
@@ -132,8 +269,19 @@ static void app_init() {
   sdtx_desc_t sdtx_desc = {.fonts = {sdtx_font_kc854()}, .logger.func = slog_func};
   sdtx_setup(&sdtx_desc);
 
+  // FRAME_TRACE=file records a trace of the whole run, written at exit.
+  if (const char *trace = getenv("FRAME_TRACE")) {
+    s_tracePath = trace;
+    s_profiler.startTrace(s_tracePath);
+  }
+  if (const char *path = getenv("INPUT_LATENCY_CSV"))
+    s_latencyPath = path;
+
   try {
-    s_hermes->global().getPropertyAsFunction(*s_hermes, "on_init").call(*s_hermes);
+    s_onInit.install(*s_hermes);
+    s_onFrame.install(*s_hermes);
+    s_onEvent.install(*s_hermes);
+    s_onInit.call(*s_hermes);
   } catch (facebook::jsi::JSIException &e) {
     slog_func("ERROR", 1, 0, e.what(), __LINE__, __FILE__, nullptr);
     abort();
@@ -141,6 +289,18 @@ static void app_init() {
 }
 
 static void app_cleanup() {
+  if (s_profiler.tracing())
+    s_profiler.stopTrace();
+  if (s_latency.count())
+    s_latency.writeCsv(s_latencyPath);
+  // For sizing TMP_ARENA_CHUNK_SIZE.
+  printf(
+      "tmp arena: high-water %zu bytes, %zu bytes in chunks\n",
+      tmp_arena_high_water(),
+      tmp_arena_capacity());
+  s_onInit.reset();
+  s_onFrame.reset();
+  s_onEvent.reset();
   s_images.clear();
   simgui_shutdown();
   sdtx_shutdown();
@@ -158,11 +318,19 @@ static void app_event(const sapp_event *ev) {
     sapp_request_quit();
     return;
   }
+  // F2 starts and stops capturing a frame trace.
+  if (ev->type == SAPP_EVENTTYPE_KEY_DOWN && ev->key_code == SAPP_KEYCODE_F2 && !ev->key_repeat) {
+    if (s_profiler.tracing())
+      s_profiler.stopTrace();
+    else
+      s_profiler.startTrace(s_tracePath);
+    return;
+  }
 
+  if (ev->type == SAPP_EVENTTYPE_KEY_DOWN || ev->type == SAPP_EVENTTYPE_KEY_UP)
+    s_latency.consumed(s_frameCount + 1, stm_now());
   try {
-    s_hermes->global()
-        .getPropertyAsFunction(*s_hermes, "on_event")
-        .call(*s_hermes, (double)ev->type, (double)ev->key_code, (double)ev->modifiers);
+    s_onEvent.call(*s_hermes, (double)ev->type, (double)ev->key_code, (double)ev->modifiers);
   } catch (facebook::jsi::JSIException &e) {
     slog_func("ERROR", 1, 0, e.what(), __LINE__, __FILE__, nullptr);
   }
@@ -178,18 +346,12 @@ extern "C" float *get_bg_color() {
 
 static void app_frame() {
   uint64_t now = stm_now();
+  s_profiler.beginFrame();
+  s_latency.rendered(++s_frameCount);
 
   if (!s_started) {
     s_started = true;
     s_start_time = now;
-    s_last_fps_time = now;
-  } else {
-    // Update FPS every second
-    uint64_t diff = stm_diff(now, s_last_fps_time);
-    if (diff > 1000000000) {
-      s_fps = 1.0 / sapp_frame_duration(); // stm_sec(diff);
-      s_last_fps_time = now;
-    }
   }
 
   simgui_new_frame({
@@ -209,19 +371,30 @@ static void app_frame() {
   sg_begin_default_pass(&pass_action, sapp_width(), sapp_height());
 
   try {
-    s_hermes->global()
-        .getPropertyAsFunction(*s_hermes, "on_frame")
-        .call(*s_hermes, sapp_widthf(), sapp_heightf(), stm_sec(stm_diff(now, s_start_time)));
+    ScopedStage stage(s_profiler, STAGE_ON_FRAME);
+    s_onFrame.call(*s_hermes, sapp_widthf(), sapp_heightf(), stm_sec(stm_diff(now, s_start_time)));
   } catch (facebook::jsi::JSIException &e) {
     slog_func("ERROR", 1, 0, e.what(), __LINE__, __FILE__, nullptr);
   }
 
-  simgui_render();
+  {
+    ScopedStage stage(s_profiler, STAGE_SIMGUI_RENDER);
+    simgui_render();
+  }
   sdtx_canvas((float)sapp_width(), (float)sapp_height());
-  sdtx_printf("FPS: %d", (int)(s_fps + 0.5));
-  sdtx_draw();
+  s_profiler.printOverlay();
+  s_latency.printOverlay();
+  {
+    ScopedStage stage(s_profiler, STAGE_SDTX);
+    sdtx_draw();
+  }
   sg_end_pass();
-  sg_commit();
+  {
+    ScopedStage stage(s_profiler, STAGE_COMMIT);
+    sg_commit();
+  }
+  s_latency.committed();
+  s_profiler.endFrame();
 }
 
 static sapp_desc s_app_desc{};
@@ -246,6 +419,8 @@ extern "C" SHUnit sh_export_demo;
 
 sapp_desc sokol_main(int argc, char* argv[]) {
   SHRuntime *shr = _sh_init(argc, argv);
+  // The JS code creates its views while the unit is initialized.
+  install_native_views(*_sh_get_hermes_runtime(shr));
   if (!_sh_initialize_units(shr, 1, &sh_export_demo))
     abort();
 
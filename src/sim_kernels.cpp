@@ -0,0 +1,234 @@
+#include "sim_kernels.h"
+
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SIM_KERNELS_X86 1
+#include <immintrin.h>
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#else
+#define SIM_KERNELS_X86 0
+#endif
+
+// MSVC lets any function use AVX intrinsics; GCC and Clang have to be told
+// per function, so that the rest of the file still runs on any x86 CPU.
+#if defined(_MSC_VER) && !defined(__clang__)
+#define TARGET_SSE2
+#define TARGET_AVX2
+#else
+#define TARGET_SSE2 __attribute__((target("sse2")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace {
+
+struct Kernels {
+  void (*integrate)(float *, const float *, size_t);
+  void (*age)(float *, const float *, float *, size_t);
+  void (*interpolate)(const float *, const float *, float, float *, size_t);
+};
+
+// Every kernel works on one coordinate at a time: the x and y columns are
+// processed by two calls, which keeps the number of live streams small.
+
+void integrateScalar(float *__restrict p, const float *__restrict v, size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    p[i] += v[i];
+}
+
+void ageScalar(
+    float *__restrict life,
+    const float *__restrict maxLife,
+    float *__restrict alpha,
+    size_t n) {
+  for (size_t i = 0; i < n; ++i) {
+    ++life[i];
+    alpha[i] = 1 - life[i] / maxLife[i];
+  }
+}
+
+void interpolateScalar(
+    const float *__restrict p,
+    const float *__restrict old,
+    float dt,
+    float *__restrict out,
+    size_t n) {
+  for (size_t i = 0; i < n; ++i)
+    out[i] = p[i] + (p[i] - old[i]) * dt;
+}
+
+const Kernels kScalar = {integrateScalar, ageScalar, interpolateScalar};
+
+#if SIM_KERNELS_X86
+
+TARGET_SSE2 void integrateSSE2(float *p, const float *v, size_t n) {
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4)
+    _mm_storeu_ps(p + i, _mm_add_ps(_mm_loadu_ps(p + i), _mm_loadu_ps(v + i)));
+  integrateScalar(p + i, v + i, n - i);
+}
+
+TARGET_SSE2 void ageSSE2(float *life, const float *maxLife, float *alpha, size_t n) {
+  const __m128 one = _mm_set1_ps(1);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 l = _mm_add_ps(_mm_loadu_ps(life + i), one);
+    _mm_storeu_ps(life + i, l);
+    _mm_storeu_ps(alpha + i, _mm_sub_ps(one, _mm_div_ps(l, _mm_loadu_ps(maxLife + i))));
+  }
+  ageScalar(life + i, maxLife + i, alpha + i, n - i);
+}
+
+TARGET_SSE2 void interpolateSSE2(const float *p, const float *old, float dt, float *out, size_t n) {
+  const __m128 vdt = _mm_set1_ps(dt);
+  size_t i = 0;
+  for (; i + 4 <= n; i += 4) {
+    __m128 cur = _mm_loadu_ps(p + i);
+    __m128 delta = _mm_sub_ps(cur, _mm_loadu_ps(old + i));
+    _mm_storeu_ps(out + i, _mm_add_ps(cur, _mm_mul_ps(delta, vdt)));
+  }
+  interpolateScalar(p + i, old + i, dt, out + i, n - i);
+}
+
+const Kernels kSSE2 = {integrateSSE2, ageSSE2, interpolateSSE2};
+
+TARGET_AVX2 void integrateAVX2(float *p, const float *v, size_t n) {
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8)
+    _mm256_storeu_ps(p + i, _mm256_add_ps(_mm256_loadu_ps(p + i), _mm256_loadu_ps(v + i)));
+  integrateScalar(p + i, v + i, n - i);
+}
+
+TARGET_AVX2 void ageAVX2(float *life, const float *maxLife, float *alpha, size_t n) {
+  const __m256 one = _mm256_set1_ps(1);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 l = _mm256_add_ps(_mm256_loadu_ps(life + i), one);
+    _mm256_storeu_ps(life + i, l);
+    _mm256_storeu_ps(
+        alpha + i, _mm256_sub_ps(one, _mm256_div_ps(l, _mm256_loadu_ps(maxLife + i))));
+  }
+  ageScalar(life + i, maxLife + i, alpha + i, n - i);
+}
+
+TARGET_AVX2 void interpolateAVX2(const float *p, const float *old, float dt, float *out, size_t n) {
+  const __m256 vdt = _mm256_set1_ps(dt);
+  size_t i = 0;
+  for (; i + 8 <= n; i += 8) {
+    __m256 cur = _mm256_loadu_ps(p + i);
+    __m256 delta = _mm256_sub_ps(cur, _mm256_loadu_ps(old + i));
+    _mm256_storeu_ps(out + i, _mm256_add_ps(cur, _mm256_mul_ps(delta, vdt)));
+  }
+  interpolateScalar(p + i, old + i, dt, out + i, n - i);
+}
+
+const Kernels kAVX2 = {integrateAVX2, ageAVX2, interpolateAVX2};
+
+#endif // SIM_KERNELS_X86
+
+const Kernels &kernelsFor(SimdLevel level) {
+#if SIM_KERNELS_X86
+  switch (level) {
+    case SimdLevel::AVX2:
+      return kAVX2;
+    case SimdLevel::SSE2:
+      return kSSE2;
+    case SimdLevel::Scalar:
+      break;
+  }
+#endif
+  return kScalar;
+}
+
+SimdLevel s_level = simd_detect();
+const Kernels *s_kernels = &kernelsFor(s_level);
+
+} // namespace
+
+SimdLevel simd_detect() {
+#if !SIM_KERNELS_X86
+  return SimdLevel::Scalar;
+#elif defined(_MSC_VER) && !defined(__clang__)
+  // AVX2 needs both the CPUID bit and OS support for saving the YMM state.
+  int info[4];
+  __cpuid(info, 0);
+  if (info[0] >= 7) {
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    __cpuidex(info, 7, 0);
+    bool avx2 = (info[1] & (1 << 5)) != 0;
+    if (osxsave && avx && avx2 && (_xgetbv(0) & 6) == 6)
+      return SimdLevel::AVX2;
+  }
+  return SimdLevel::SSE2;
+#else
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2"))
+    return SimdLevel::AVX2;
+  if (__builtin_cpu_supports("sse2"))
+    return SimdLevel::SSE2;
+  return SimdLevel::Scalar;
+#endif
+}
+
+SimdLevel simd_level() {
+  return s_level;
+}
+
+SimdLevel simd_set_level(SimdLevel level) {
+  SimdLevel best = simd_detect();
+  if ((int)level > (int)best)
+    level = best;
+  s_level = level;
+  s_kernels = &kernelsFor(level);
+  return level;
+}
+
+const char *simd_level_name(SimdLevel level) {
+  switch (level) {
+    case SimdLevel::Scalar:
+      return "scalar";
+    case SimdLevel::SSE2:
+      return "sse2";
+    case SimdLevel::AVX2:
+      return "avx2";
+  }
+  return "?";
+}
+
+void kernel_integrate(
+    float *x,
+    float *y,
+    float *oldX,
+    float *oldY,
+    const float *velX,
+    const float *velY,
+    size_t n,
+    bool save) {
+  if (save) {
+    memcpy(oldX, x, n * sizeof(float));
+    memcpy(oldY, y, n * sizeof(float));
+  }
+  s_kernels->integrate(x, velX, n);
+  s_kernels->integrate(y, velY, n);
+}
+
+void kernel_age(float *life, const float *maxLife, float *alpha, size_t n) {
+  s_kernels->age(life, maxLife, alpha, n);
+}
+
+void kernel_interpolate(
+    const float *x,
+    const float *y,
+    const float *oldX,
+    const float *oldY,
+    float dt,
+    float *outX,
+    float *outY,
+    size_t n) {
+  s_kernels->interpolate(x, oldX, dt, outX, n);
+  s_kernels->interpolate(y, oldY, dt, outY, n);
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstddef>
+
+// Bulk kernels over the entity columns, with SSE2 and AVX2 versions picked at
+// runtime and a portable scalar fallback. All versions perform the same IEEE
+// operations in the same order (no FMA contraction, no reciprocal
+// approximations), so their results are bit-for-bit identical.
+
+enum class SimdLevel { Scalar, SSE2, AVX2 };
+
+/// The best level supported by this CPU.
+SimdLevel simd_detect();
+/// The level currently used by the kernels. Defaults to simd_detect().
+SimdLevel simd_level();
+/// Select the kernels to use. Levels the CPU doesn't support are lowered to
+/// the best supported one. Returns the level actually selected.
+SimdLevel simd_set_level(SimdLevel level);
+const char *simd_level_name(SimdLevel level);
+
+/// x += velX, y += velY for \p n entities, copying x/y into oldX/oldY first if
+/// \p save is set.
+void kernel_integrate(
+    float *x,
+    float *y,
+    float *oldX,
+    float *oldY,
+    const float *velX,
+    const float *velY,
+    size_t n,
+    bool save);
+
+/// Advance the age of \p n particles by one tick and recompute their alpha as
+/// 1 - life / maxLife.
+void kernel_age(float *life, const float *maxLife, float *alpha, size_t n);
+
+/// Write the positions interpolated by \p dt between old and current position
+/// into \p outX and \p outY.
+void kernel_interpolate(
+    const float *x,
+    const float *y,
+    const float *oldX,
+    const float *oldY,
+    float dt,
+    float *outX,
+    float *outY,
+    size_t n);
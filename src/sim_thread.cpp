@@ -0,0 +1,86 @@
+#include "sim_thread.h"
+
+#include "sokol_time.h"
+
+#include <chrono>
+
+void SimThread::start(uint64_t startTime) {
+  stop();
+  startTime_ = startTime;
+  quit_ = false;
+  ticks_ = dropped_ = late_ = 0;
+  tickTime_ = 0;
+  publish(0, 0, 0, 0);
+  thread_ = std::thread([this] { run(); });
+}
+
+void SimThread::stop() {
+  if (!thread_.joinable())
+    return;
+  {
+    std::lock_guard<std::mutex> lock(wakeMutex_);
+    quit_ = true;
+  }
+  wake_.notify_one();
+  thread_.join();
+}
+
+void SimThread::publish(double lastTime, double time, uint64_t batchStart, uint64_t batchEnd) {
+  Frame &frame = frames_.back();
+  game_snapshot(frame.game);
+  frame.lastTime = lastTime;
+  frame.time = time;
+  frame.tickTime = tickTime_;
+  frame.batchStart = batchStart;
+  frame.batchEnd = batchEnd;
+  frames_.publish();
+}
+
+void SimThread::run() {
+  double gameTime = 0;
+  for (;;) {
+    double now = stm_sec(stm_diff(stm_now(), startTime_));
+    // Steps of the clock in this batch, and how many of them ran a tick: while
+    // paused the clock still advances, but no tick runs and none is counted.
+    unsigned steps = 0, ticks = 0;
+    uint64_t batchStart = 0, batchEnd = 0;
+    bool paused = paused_.load(std::memory_order_relaxed);
+    if (paused)
+      game_drain_input();
+    // Run every tick whose time has come, like the old loop in app_frame(),
+    // so that the state is always just ahead of the clock.
+    while (gameTime <= now && steps < MAX_CATCH_UP) {
+      bool late = now - gameTime > PHYS_DT;
+      gameTime += PHYS_DT;
+      ++steps;
+      if (paused)
+        continue;
+      if (late)
+        late_.fetch_add(1, std::memory_order_relaxed);
+      uint64_t start = stm_now();
+      update_game_state(ticks == 0);
+      batchEnd = stm_now();
+      if (!batchStart)
+        batchStart = start;
+      tickTime_ += stm_diff(batchEnd, start);
+      ++ticks;
+    }
+    if (gameTime <= now) {
+      uint64_t behind = (uint64_t)((now - gameTime) / PHYS_DT) + 1;
+      if (!paused)
+        dropped_.fetch_add(behind, std::memory_order_relaxed);
+      gameTime += behind * (double)PHYS_DT;
+    }
+    if (steps)
+      publish(gameTime - steps * (double)PHYS_DT, gameTime, batchStart, batchEnd);
+    ticks_.fetch_add(ticks, std::memory_order_relaxed);
+
+    // Sleep until the next tick is due.
+    double wait = gameTime - stm_sec(stm_diff(stm_now(), startTime_));
+    std::unique_lock<std::mutex> lock(wakeMutex_);
+    if (wait > 0)
+      wake_.wait_for(lock, std::chrono::duration<double>(wait), [this] { return quit_; });
+    if (quit_)
+      return;
+  }
+}
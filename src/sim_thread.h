@@ -0,0 +1,105 @@
+#pragma once
+
+#include "game.h"
+#include "triple_buffer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+
+/// Runs the game simulation at PHYS_FPS on its own thread, so that a slow
+/// frame doesn't delay ticks and a slow tick doesn't delay rendering.
+///
+/// After every batch of ticks the thread copies the state into a
+/// SimThread::Frame and publishes it through a TripleBuffer. The render
+/// thread picks up the latest one with acquire() and interpolates between its
+/// two times.
+///
+/// Input reaches the game through game_post_key(), which the ticks drain, so
+/// no other thread touches the game state while the thread runs.
+///
+/// When the simulation falls more than MAX_CATCH_UP ticks behind the clock,
+/// the rest are dropped instead of run, so the game slows down rather than
+/// spending ever longer catching up.
+class SimThread {
+ public:
+  /// Most ticks run back to back before the simulation gives up on catching
+  /// up.
+  static constexpr unsigned MAX_CATCH_UP = 5;
+
+  struct Frame {
+    GameSnapshot game;
+    /// Game time, in seconds since start(), before the batch of ticks that
+    /// produced this state (which the old positions correspond to) and after
+    /// it.
+    double lastTime = 0;
+    double time = 0;
+    /// Time spent in update_game_state() since start(), and the span of the
+    /// batch of ticks that produced this state, in sokol_time ticks. The
+    /// render thread charges the difference between two frames to its
+    /// profiler.
+    uint64_t tickTime = 0;
+    uint64_t batchStart = 0, batchEnd = 0;
+  };
+
+  ~SimThread() {
+    stop();
+  }
+
+  /// Publish the current state and start ticking, with game time 0 at
+  /// \p startTime (in sokol_time ticks).
+  void start(uint64_t startTime);
+  /// Stop the thread and wait for it. The game state stays as it was after
+  /// the last tick.
+  void stop();
+  bool running() const {
+    return thread_.joinable();
+  }
+
+  /// Keep the clock running without ticking. Posted input is still drained,
+  /// with game_drain_input(). Nothing is counted by ticks(), dropped() or
+  /// late() while paused.
+  void setPaused(bool paused) {
+    paused_.store(paused, std::memory_order_relaxed);
+  }
+
+  /// Make the latest published frame current, and return it.
+  const Frame &acquire() {
+    frames_.acquire();
+    return frames_.front();
+  }
+
+  /// Ticks run since start().
+  uint64_t ticks() const {
+    return ticks_.load(std::memory_order_relaxed);
+  }
+  /// Ticks skipped because the simulation was too far behind.
+  uint64_t dropped() const {
+    return dropped_.load(std::memory_order_relaxed);
+  }
+  /// Ticks that ran more than a tick period after their scheduled time.
+  uint64_t late() const {
+    return late_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  std::thread thread_;
+  uint64_t startTime_ = 0;
+  TripleBuffer<Frame> frames_;
+
+  std::atomic<bool> paused_{false};
+
+  /// Guards quit_, and wakes the thread from its sleep between ticks.
+  std::mutex wakeMutex_;
+  std::condition_variable wake_;
+  bool quit_ = false;
+
+  std::atomic<uint64_t> ticks_{0}, dropped_{0}, late_{0};
+  /// Frame::tickTime. Only used by the thread.
+  uint64_t tickTime_ = 0;
+
+  void run();
+  void publish(double lastTime, double time, uint64_t batchStart, uint64_t batchEnd);
+};
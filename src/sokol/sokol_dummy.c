@@ -0,0 +1,20 @@
+/*
+* Copyright (c) Tzvetan Mikov.
+*
+* This source code is licensed under the MIT license found in the
+* LICENSE file in the root directory of this source tree.
+ */
+
+// sokol_gfx and sokol_imgui on the dummy backend, without sokol_app, for
+// headless tools that measure the CPU side of rendering.
+
+#define SOKOL_IMPL
+#include "sokol_gfx.h"
+#include "sokol_log.h"
+#include "sokol_time.h"
+
+#define CIMGUI_DEFINE_ENUMS_AND_STRUCTS
+#include "cimgui.h"
+#define SOKOL_IMGUI_IMPL
+#define SOKOL_IMGUI_NO_SOKOL_APP
+#include "sokol_imgui.h"
@@ -92,15 +92,36 @@
         simgui_setup(const simgui_desc_t* desc)
 
         This will initialize Dear ImGui and create sokol-gfx resources
-        (two buffers for vertices and indices, a font texture and a pipeline-
-        state-object).
+        (a ring of vertex- and index-buffer pairs, a font texture and a
+        pipeline-state-object).
 
         Use the following simgui_desc_t members to configure behaviour:
 
             int max_vertices
-                The maximum number of vertices used for UI rendering, default is 65536.
-                sokol-imgui will use this to compute the size of the vertex-
-                and index-buffers allocated via sokol_gfx.h
+                The initial number of vertices used for UI rendering, default is 65536.
+                sokol-imgui will use this to compute the initial size of the vertex-
+                and index-buffers allocated via sokol_gfx.h. Buffers that turn
+                out too small for a frame are re-allocated with at least twice
+                the size, so no geometry is ever dropped.
+
+            int num_upload_buffers
+                The number of vertex- and index-buffer pairs, default is 2.
+                Each call to simgui_render() uses the next pair of the ring,
+                so a pair isn't written again until N-1 other renders have
+                been issued.
+
+            simgui_upload_mode_t upload_mode
+                How simgui_render() gets the geometry into the upload buffers:
+
+                SIMGUI_UPLOADMODE_UPDATE: copy all draw lists into an
+                    intermediate buffer and upload it with a single
+                    sg_update_buffer() call per buffer. This is the default on
+                    the GL backends, where sg_append_buffer() has performance
+                    problems on some platforms.
+                SIMGUI_UPLOADMODE_APPEND: append each draw list straight from
+                    ImGui's own arrays with sg_append_buffer(), without the
+                    intermediate copy. This is the default on all other
+                    backends.
 
             int image_pool_size
                 Number of simgui_image_t objects which can be alive at the same time.
@@ -202,6 +223,19 @@
         This will first call ImGui::Render(), and then render ImGui's draw list
         through sokol_gfx.h
 
+        The vertices and indices of the ImDrawLists are uploaded into the
+        current upload buffers as selected by simgui_desc_t.upload_mode.
+
+    --- to find out how much data the last simgui_render() sent to the GPU,
+        call:
+
+        simgui_frame_stats_t simgui_query_frame_stats(void)
+
+        This returns the number of draw lists, vertices and indices
+        rendered, the bytes uploaded to the vertex- and index-buffers
+        (including alignment padding), the current total size of the upload
+        buffers and how often they had to be re-allocated since simgui_setup().
+
     --- if you're using sokol_app.h, from inside the sokol_app.h event callback,
         call:
 
@@ -455,6 +489,7 @@ typedef struct simgui_image_desc_t {
     _SIMGUI_LOGITEM_XMACRO(OK, "Ok") \
     _SIMGUI_LOGITEM_XMACRO(MALLOC_FAILED, "memory allocation failed") \
     _SIMGUI_LOGITEM_XMACRO(IMAGE_POOL_EXHAUSTED, "image pool exhausted") \
+    _SIMGUI_LOGITEM_XMACRO(UPLOAD_BUFFER_GROWN, "vertex- or index-buffer too small, re-allocated (consider increasing simgui_desc_t.max_vertices)") \
 
 #define _SIMGUI_LOGITEM_XMACRO(item,msg) SIMGUI_LOGITEM_##item,
 typedef enum simgui_log_item_t {
@@ -498,8 +533,17 @@ typedef struct simgui_logger_t {
     void* user_data;
 } simgui_logger_t;
 
+typedef enum simgui_upload_mode_t {
+    _SIMGUI_UPLOADMODE_DEFAULT,     // UPDATE on the GL backends, APPEND otherwise
+    SIMGUI_UPLOADMODE_UPDATE,
+    SIMGUI_UPLOADMODE_APPEND,
+    _SIMGUI_UPLOADMODE_FORCE_U32 = 0x7FFFFFFF
+} simgui_upload_mode_t;
+
 typedef struct simgui_desc_t {
-    int max_vertices;               // default: 65536
+    int max_vertices;               // default: 65536, initial size of the upload buffers
+    int num_upload_buffers;         // default: 2
+    simgui_upload_mode_t upload_mode;
     int image_pool_size;            // default: 256
     sg_pixel_format color_format;
     sg_pixel_format depth_format;
@@ -514,6 +558,17 @@ typedef struct simgui_desc_t {
     simgui_logger_t logger;         // optional log function override
 } simgui_desc_t;
 
+typedef struct simgui_frame_stats_t {
+    int num_draw_lists;
+    int num_vertices;
+    int num_indices;
+    size_t vertex_bytes;            // bytes uploaded to the vertex buffer, including padding
+    size_t index_bytes;             // bytes uploaded to the index buffer, including padding
+    size_t total_bytes;             // vertex_bytes + index_bytes
+    size_t buffer_bytes;            // current size of all upload buffers together
+    int num_buffer_grows;           // re-allocations since simgui_setup()
+} simgui_frame_stats_t;
+
 typedef struct simgui_frame_desc_t {
     int width;
     int height;
@@ -524,6 +579,7 @@ typedef struct simgui_frame_desc_t {
 SOKOL_IMGUI_API_DECL void simgui_setup(const simgui_desc_t* desc);
 SOKOL_IMGUI_API_DECL void simgui_new_frame(const simgui_frame_desc_t* desc);
 SOKOL_IMGUI_API_DECL void simgui_render(void);
+SOKOL_IMGUI_API_DECL simgui_frame_stats_t simgui_query_frame_stats(void);
 SOKOL_IMGUI_API_DECL simgui_image_t simgui_make_image(const simgui_image_desc_t* desc);
 SOKOL_IMGUI_API_DECL void simgui_destroy_image(simgui_image_t img);
 SOKOL_IMGUI_API_DECL simgui_image_desc_t simgui_query_image_desc(simgui_image_t img);
@@ -646,12 +702,22 @@ typedef struct {
     _simgui_image_t* items;
 } _simgui_image_pool_t;
 
+typedef struct {
+    sg_buffer vbuf;
+    sg_buffer ibuf;
+    size_t vbuf_size;
+    size_t ibuf_size;
+} _simgui_upload_buffer_t;
+
 typedef struct {
     uint32_t init_cookie;
     simgui_desc_t desc;
     float cur_dpi_scale;
-    sg_buffer vbuf;
-    sg_buffer ibuf;
+    _simgui_upload_buffer_t* upload_buffers;
+    int cur_upload_buffer;
+    sg_range vertices;      // intermediate buffers of SIMGUI_UPLOADMODE_UPDATE
+    sg_range indices;
+    simgui_frame_stats_t frame_stats;
     sg_image font_img;
     sg_sampler font_smp;
     simgui_image_t default_font;
@@ -659,8 +725,6 @@ typedef struct {
     sg_sampler def_smp;     // used as default sampler for user images
     sg_shader shd;
     sg_pipeline pip;
-    sg_range vertices;
-    sg_range indices;
     bool is_osx;
     _simgui_image_pool_t image_pool;
 } _simgui_state_t;
@@ -2196,10 +2260,82 @@ static bool _simgui_is_osx(void) {
     #endif
 }
 
+static sg_buffer _simgui_make_vertex_buffer(size_t size) {
+    // NOTE: since we're in C++ mode here we can't use C99 designated init
+    sg_buffer_desc vb_desc;
+    _simgui_clear(&vb_desc, sizeof(vb_desc));
+    vb_desc.usage = SG_USAGE_STREAM;
+    vb_desc.size = size;
+    vb_desc.label = "sokol-imgui-vertices";
+    return sg_make_buffer(&vb_desc);
+}
+
+static sg_buffer _simgui_make_index_buffer(size_t size) {
+    sg_buffer_desc ib_desc;
+    _simgui_clear(&ib_desc, sizeof(ib_desc));
+    ib_desc.type = SG_BUFFERTYPE_INDEXBUFFER;
+    ib_desc.usage = SG_USAGE_STREAM;
+    ib_desc.size = size;
+    ib_desc.label = "sokol-imgui-indices";
+    return sg_make_buffer(&ib_desc);
+}
+
+// sg_append_buffer() starts every chunk at a multiple of 4 bytes
+static size_t _simgui_append_size(size_t size) {
+    return (size + 3) & ~(size_t)3;
+}
+
+// make sure an intermediate buffer has room for size bytes
+static void _simgui_reserve_range(sg_range* range, size_t size) {
+    if (range->size >= size) {
+        return;
+    }
+    if (range->ptr) {
+        _simgui_free((void*)range->ptr);
+    }
+    range->ptr = _simgui_malloc(size);
+    range->size = size;
+}
+
+// make sure the buffer pair can take vtx_size and idx_size more bytes this frame,
+// re-allocating whichever is too small
+static void _simgui_reserve_upload_buffer(_simgui_upload_buffer_t* ub, size_t vtx_size, size_t idx_size) {
+    if (sg_query_buffer_will_overflow(ub->vbuf, vtx_size)) {
+        size_t new_size = ub->vbuf_size * 2;
+        while (new_size < vtx_size) {
+            new_size *= 2;
+        }
+        _SIMGUI_INFO(UPLOAD_BUFFER_GROWN);
+        sg_destroy_buffer(ub->vbuf);
+        ub->vbuf = _simgui_make_vertex_buffer(new_size);
+        _simgui.frame_stats.buffer_bytes += new_size - ub->vbuf_size;
+        _simgui.frame_stats.num_buffer_grows++;
+        ub->vbuf_size = new_size;
+    }
+    if (sg_query_buffer_will_overflow(ub->ibuf, idx_size)) {
+        size_t new_size = ub->ibuf_size * 2;
+        while (new_size < idx_size) {
+            new_size *= 2;
+        }
+        _SIMGUI_INFO(UPLOAD_BUFFER_GROWN);
+        sg_destroy_buffer(ub->ibuf);
+        ub->ibuf = _simgui_make_index_buffer(new_size);
+        _simgui.frame_stats.buffer_bytes += new_size - ub->ibuf_size;
+        _simgui.frame_stats.num_buffer_grows++;
+        ub->ibuf_size = new_size;
+    }
+}
+
 static simgui_desc_t _simgui_desc_defaults(const simgui_desc_t* desc) {
     SOKOL_ASSERT((desc->allocator.alloc_fn && desc->allocator.free_fn) || (!desc->allocator.alloc_fn && !desc->allocator.free_fn));
     simgui_desc_t res = *desc;
     res.max_vertices = _simgui_def(res.max_vertices, 65536);
+    res.num_upload_buffers = _simgui_def(res.num_upload_buffers, 2);
+    #if defined(SOKOL_GLCORE33) || defined(SOKOL_GLES3)
+    res.upload_mode = _simgui_def(res.upload_mode, SIMGUI_UPLOADMODE_UPDATE);
+    #else
+    res.upload_mode = _simgui_def(res.upload_mode, SIMGUI_UPLOADMODE_APPEND);
+    #endif
     res.image_pool_size = _simgui_def(res.image_pool_size, 256);
     return res;
 }
@@ -2226,13 +2362,6 @@ SOKOL_API_IMPL void simgui_setup(const simgui_desc_t* desc) {
     // setup image pool
     _simgui_setup_image_pool(_simgui.desc.image_pool_size);
 
-    // allocate an intermediate vertex- and index-buffer
-    SOKOL_ASSERT(_simgui.desc.max_vertices > 0);
-    _simgui.vertices.size = (size_t)_simgui.desc.max_vertices * sizeof(ImDrawVert);
-    _simgui.vertices.ptr = _simgui_malloc(_simgui.vertices.size);
-    _simgui.indices.size = (size_t)_simgui.desc.max_vertices * 3 * sizeof(ImDrawIdx);
-    _simgui.indices.ptr = _simgui_malloc(_simgui.indices.size);
-
     // initialize Dear ImGui
     #if defined(__cplusplus)
         ImGui::CreateContext();
@@ -2264,21 +2393,19 @@ SOKOL_API_IMPL void simgui_setup(const simgui_desc_t* desc) {
     // create sokol-gfx resources
     sg_push_debug_group("sokol-imgui");
 
-    // NOTE: since we're in C++ mode here we can't use C99 designated init
-    sg_buffer_desc vb_desc;
-    _simgui_clear(&vb_desc, sizeof(vb_desc));
-    vb_desc.usage = SG_USAGE_STREAM;
-    vb_desc.size = _simgui.vertices.size;
-    vb_desc.label = "sokol-imgui-vertices";
-    _simgui.vbuf = sg_make_buffer(&vb_desc);
-
-    sg_buffer_desc ib_desc;
-    _simgui_clear(&ib_desc, sizeof(ib_desc));
-    ib_desc.type = SG_BUFFERTYPE_INDEXBUFFER;
-    ib_desc.usage = SG_USAGE_STREAM;
-    ib_desc.size = _simgui.indices.size;
-    ib_desc.label = "sokol-imgui-indices";
-    _simgui.ibuf = sg_make_buffer(&ib_desc);
+    // the ring of vertex- and index-buffers
+    SOKOL_ASSERT(_simgui.desc.max_vertices > 0);
+    SOKOL_ASSERT(_simgui.desc.num_upload_buffers > 0);
+    const size_t num_upload_buffers = (size_t)_simgui.desc.num_upload_buffers;
+    _simgui.upload_buffers = (_simgui_upload_buffer_t*) _simgui_malloc_clear(num_upload_buffers * sizeof(_simgui_upload_buffer_t));
+    for (size_t i = 0; i < num_upload_buffers; i++) {
+        _simgui_upload_buffer_t* ub = &_simgui.upload_buffers[i];
+        ub->vbuf_size = (size_t)_simgui.desc.max_vertices * sizeof(ImDrawVert);
+        ub->ibuf_size = (size_t)_simgui.desc.max_vertices * 3 * sizeof(ImDrawIdx);
+        ub->vbuf = _simgui_make_vertex_buffer(ub->vbuf_size);
+        ub->ibuf = _simgui_make_index_buffer(ub->ibuf_size);
+        _simgui.frame_stats.buffer_bytes += ub->vbuf_size + ub->ibuf_size;
+    }
 
     // a default font sampler
     sg_sampler_desc font_smp_desc;
@@ -2456,16 +2583,22 @@ SOKOL_API_IMPL void simgui_shutdown(void) {
     sg_destroy_image(_simgui.font_img);
     sg_destroy_sampler(_simgui.def_smp);
     sg_destroy_image(_simgui.def_img);
-    sg_destroy_buffer(_simgui.ibuf);
-    sg_destroy_buffer(_simgui.vbuf);
+    for (int i = 0; i < _simgui.desc.num_upload_buffers; i++) {
+        sg_destroy_buffer(_simgui.upload_buffers[i].ibuf);
+        sg_destroy_buffer(_simgui.upload_buffers[i].vbuf);
+    }
     sg_pop_debug_group();
     sg_push_debug_group("sokol-imgui");
     _simgui_destroy_all_images();
     _simgui_discard_image_pool();
-    SOKOL_ASSERT(_simgui.vertices.ptr);
-    _simgui_free((void*)_simgui.vertices.ptr);
-    SOKOL_ASSERT(_simgui.indices.ptr);
-    _simgui_free((void*)_simgui.indices.ptr);
+    SOKOL_ASSERT(_simgui.upload_buffers);
+    _simgui_free((void*)_simgui.upload_buffers);
+    if (_simgui.vertices.ptr) {
+        _simgui_free((void*)_simgui.vertices.ptr);
+    }
+    if (_simgui.indices.ptr) {
+        _simgui_free((void*)_simgui.indices.ptr);
+    }
     _simgui.init_cookie = 0;
 }
 
@@ -2598,57 +2731,67 @@ SOKOL_API_IMPL void simgui_render(void) {
     if (draw_data->CmdListsCount == 0) {
         return;
     }
-    /* copy vertices and indices into an intermediate buffer so that
-       they can be updated with a single sg_update_buffer() call each
-       (sg_append_buffer() has performance problems on some GL platforms),
-       also keep track of valid number of command lists in case of a
-       buffer overflow
+    /* size up this frame's geometry, padded the same way as sg_append_buffer()
+       does, and grow the upload buffers if necessary so that nothing is dropped
     */
     size_t all_vtx_size = 0;
     size_t all_idx_size = 0;
-    int cmd_list_count = 0;
-    for (int cl_index = 0; cl_index < draw_data->CmdListsCount; cl_index++, cmd_list_count++) {
+    int all_vtx_count = 0;
+    int all_idx_count = 0;
+    const int cmd_list_count = draw_data->CmdListsCount;
+    for (int cl_index = 0; cl_index < cmd_list_count; cl_index++) {
         ImDrawList* cl = _simgui_imdrawlist_at(draw_data, cl_index);
-        const size_t vtx_size = (size_t)cl->VtxBuffer.Size * sizeof(ImDrawVert);
-        const size_t idx_size = (size_t)cl->IdxBuffer.Size * sizeof(ImDrawIdx);
+        all_vtx_size += _simgui_append_size((size_t)cl->VtxBuffer.Size * sizeof(ImDrawVert));
+        all_idx_size += _simgui_append_size((size_t)cl->IdxBuffer.Size * sizeof(ImDrawIdx));
+        all_vtx_count += cl->VtxBuffer.Size;
+        all_idx_count += cl->IdxBuffer.Size;
+    }
+    _simgui_upload_buffer_t* ub = &_simgui.upload_buffers[_simgui.cur_upload_buffer];
+    _simgui.cur_upload_buffer = (_simgui.cur_upload_buffer + 1) % _simgui.desc.num_upload_buffers;
 
-        // check for buffer overflow
-        if (((all_vtx_size + vtx_size) > _simgui.vertices.size) ||
-            ((all_idx_size + idx_size) > _simgui.indices.size))
-        {
-            break;
+    sg_push_debug_group("sokol-imgui");
+    _simgui_reserve_upload_buffer(ub, all_vtx_size, all_idx_size);
+    const bool append = _simgui.desc.upload_mode == SIMGUI_UPLOADMODE_APPEND;
+    if (!append) {
+        /* copy vertices and indices into an intermediate buffer so that
+           they can be updated with a single sg_update_buffer() call each
+           (sg_append_buffer() has performance problems on some GL platforms),
+           at the same offsets that sg_append_buffer() would use
+        */
+        _simgui_reserve_range(&_simgui.vertices, all_vtx_size);
+        _simgui_reserve_range(&_simgui.indices, all_idx_size);
+        size_t vtx_pos = 0;
+        size_t idx_pos = 0;
+        for (int cl_index = 0; cl_index < cmd_list_count; cl_index++) {
+            ImDrawList* cl = _simgui_imdrawlist_at(draw_data, cl_index);
+            const size_t vtx_size = (size_t)cl->VtxBuffer.Size * sizeof(ImDrawVert);
+            const size_t idx_size = (size_t)cl->IdxBuffer.Size * sizeof(ImDrawIdx);
+            if (vtx_size > 0) {
+                memcpy(((uint8_t*)_simgui.vertices.ptr) + vtx_pos, cl->VtxBuffer.Data, vtx_size);
+            }
+            if (idx_size > 0) {
+                memcpy(((uint8_t*)_simgui.indices.ptr) + idx_pos, cl->IdxBuffer.Data, idx_size);
+            }
+            vtx_pos += _simgui_append_size(vtx_size);
+            idx_pos += _simgui_append_size(idx_size);
         }
-
-        // copy vertices and indices into common buffers
-        if (vtx_size > 0) {
-            const ImDrawVert* src_vtx_ptr = cl->VtxBuffer.Data;
-            void* dst_vtx_ptr = (void*) (((uint8_t*)_simgui.vertices.ptr) + all_vtx_size);
-            memcpy(dst_vtx_ptr, src_vtx_ptr, vtx_size);
+        if (all_vtx_size > 0) {
+            sg_range vtx_data = _simgui.vertices;
+            vtx_data.size = all_vtx_size;
+            sg_update_buffer(ub->vbuf, &vtx_data);
         }
-        if (idx_size > 0) {
-            const ImDrawIdx* src_idx_ptr = cl->IdxBuffer.Data;
-            void* dst_idx_ptr = (void*) (((uint8_t*)_simgui.indices.ptr) + all_idx_size);
-            memcpy(dst_idx_ptr, src_idx_ptr, idx_size);
+        if (all_idx_size > 0) {
+            sg_range idx_data = _simgui.indices;
+            idx_data.size = all_idx_size;
+            sg_update_buffer(ub->ibuf, &idx_data);
         }
-        all_vtx_size += vtx_size;
-        all_idx_size += idx_size;
-    }
-    if (0 == cmd_list_count) {
-        return;
-    }
-
-    // update the sokol-gfx vertex- and index-buffer
-    sg_push_debug_group("sokol-imgui");
-    if (all_vtx_size > 0) {
-        sg_range vtx_data = _simgui.vertices;
-        vtx_data.size = all_vtx_size;
-        sg_update_buffer(_simgui.vbuf, &vtx_data);
-    }
-    if (all_idx_size > 0) {
-        sg_range idx_data = _simgui.indices;
-        idx_data.size = all_idx_size;
-        sg_update_buffer(_simgui.ibuf, &idx_data);
     }
+    _simgui.frame_stats.num_draw_lists = cmd_list_count;
+    _simgui.frame_stats.num_vertices = all_vtx_count;
+    _simgui.frame_stats.num_indices = all_idx_count;
+    _simgui.frame_stats.vertex_bytes = all_vtx_size;
+    _simgui.frame_stats.index_bytes = all_idx_size;
+    _simgui.frame_stats.total_bytes = all_vtx_size + all_idx_size;
 
     // render the ImGui command list
     const float dpi_scale = _simgui.cur_dpi_scale;
@@ -2665,15 +2808,34 @@ SOKOL_API_IMPL void simgui_render(void) {
     sg_apply_uniforms(SG_SHADERSTAGE_VS, 0, SG_RANGE_REF(vs_params));
     sg_bindings bind;
     _simgui_clear((void*)&bind, sizeof(bind));
-    bind.vertex_buffers[0] = _simgui.vbuf;
-    bind.index_buffer = _simgui.ibuf;
+    bind.vertex_buffers[0] = ub->vbuf;
+    bind.index_buffer = ub->ibuf;
     ImTextureID tex_id = io->Fonts->TexID;
     _simgui_bind_image_sampler(&bind, tex_id);
-    int vb_offset = 0;
-    int ib_offset = 0;
+    size_t next_vb_offset = 0;
+    size_t next_ib_offset = 0;
     for (int cl_index = 0; cl_index < cmd_list_count; cl_index++) {
         ImDrawList* cl = _simgui_imdrawlist_at(draw_data, cl_index);
 
+        // each list gets its own offsets: either where it was copied to in the
+        // intermediate buffer, or where it gets appended straight from ImGui's arrays
+        int vb_offset = (int)next_vb_offset;
+        int ib_offset = (int)next_ib_offset;
+        next_vb_offset += _simgui_append_size((size_t)cl->VtxBuffer.Size * sizeof(ImDrawVert));
+        next_ib_offset += _simgui_append_size((size_t)cl->IdxBuffer.Size * sizeof(ImDrawIdx));
+        if (append && (cl->VtxBuffer.Size > 0)) {
+            sg_range vtx_data;
+            vtx_data.ptr = cl->VtxBuffer.Data;
+            vtx_data.size = (size_t)cl->VtxBuffer.Size * sizeof(ImDrawVert);
+            vb_offset = sg_append_buffer(ub->vbuf, &vtx_data);
+        }
+        if (append && (cl->IdxBuffer.Size > 0)) {
+            sg_range idx_data;
+            idx_data.ptr = cl->IdxBuffer.Data;
+            idx_data.size = (size_t)cl->IdxBuffer.Size * sizeof(ImDrawIdx);
+            ib_offset = sg_append_buffer(ub->ibuf, &idx_data);
+        }
+
         bind.vertex_buffer_offsets[0] = vb_offset;
         bind.index_buffer_offset = ib_offset;
         sg_apply_bindings(&bind);
@@ -2709,21 +2871,17 @@ SOKOL_API_IMPL void simgui_render(void) {
                 sg_draw((int)pcmd->IdxOffset, (int)pcmd->ElemCount, 1);
             }
         }
-        #if defined(__cplusplus)
-            const size_t vtx_size = (size_t)cl->VtxBuffer.size() * sizeof(ImDrawVert);
-            const size_t idx_size = (size_t)cl->IdxBuffer.size() * sizeof(ImDrawIdx);
-        #else
-            const size_t vtx_size = (size_t)cl->VtxBuffer.Size * sizeof(ImDrawVert);
-            const size_t idx_size = (size_t)cl->IdxBuffer.Size * sizeof(ImDrawIdx);
-        #endif
-        vb_offset += (int)vtx_size;
-        ib_offset += (int)idx_size;
     }
     sg_apply_viewport(0, 0, fb_width, fb_height, true);
     sg_apply_scissor_rect(0, 0, fb_width, fb_height, true);
     sg_pop_debug_group();
 }
 
+SOKOL_API_IMPL simgui_frame_stats_t simgui_query_frame_stats(void) {
+    SOKOL_ASSERT(_SIMGUI_INIT_COOKIE == _simgui.init_cookie);
+    return _simgui.frame_stats;
+}
+
 SOKOL_API_IMPL void simgui_add_focus_event(bool focus) {
     SOKOL_ASSERT(_SIMGUI_INIT_COOKIE == _simgui.init_cookie);
     #if defined(__cplusplus)
@@ -0,0 +1,77 @@
+#include "spatial_grid.h"
+
+#include <algorithm>
+#include <cmath>
+
+SpatialGrid::SpatialGrid(float width, float height, float cellSize)
+    : invCellSize_(1.0f / cellSize),
+      cols_(std::max(1, (int)std::ceil(width / cellSize))),
+      rows_(std::max(1, (int)std::ceil(height / cellSize))),
+      cellStart_(cols_ * rows_ + 1) {}
+
+/// Store the inclusive cell range [x0, y0, x1, y1] covered by the box in
+/// \p out. Clamping happens in float so that far away or infinite coordinates
+/// can't overflow the conversion. NaN, which fails every comparison, is
+/// tested for explicitly and goes to cell 0.
+void SpatialGrid::cellRange(float x, float y, float w, float h, int32_t *out) const {
+  auto clamp = [](float v, int32_t count) -> int32_t {
+    if (!(v >= 0.0f))
+      return 0;
+    return v >= count - 1.0f ? count - 1 : (int32_t)v;
+  };
+  out[0] = clamp(x * invCellSize_, cols_);
+  out[1] = clamp(y * invCellSize_, rows_);
+  out[2] = clamp((x + w) * invCellSize_, cols_);
+  out[3] = clamp((y + h) * invCellSize_, rows_);
+}
+
+void SpatialGrid::build(const float *x, const float *y, const float *w, const float *h, size_t n) {
+  std::fill(cellStart_.begin(), cellStart_.end(), 0);
+  range_.resize(n * 4);
+
+  // Count the entries of each cell, shifted by one so that the prefix sum
+  // below leaves cellStart_[c] at the start of cell c.
+  size_t total = 0;
+  for (size_t i = 0; i < n; ++i) {
+    int32_t *r = &range_[i * 4];
+    cellRange(x[i], y[i], w[i], h[i], r);
+    for (int32_t row = r[1]; row <= r[3]; ++row)
+      for (int32_t col = r[0]; col <= r[2]; ++col)
+        ++cellStart_[row * cols_ + col + 1];
+    total += (size_t)(r[2] - r[0] + 1) * (r[3] - r[1] + 1);
+  }
+  for (size_t c = 1; c < cellStart_.size(); ++c)
+    cellStart_[c] += cellStart_[c - 1];
+
+  // Fill in index order, so every cell list ends up sorted. cellStart_[c]
+  // is used as the write cursor of cell c - 1 and ends up at its end, which
+  // is the start of cell c.
+  items_.resize(total);
+  for (size_t i = 0; i < n; ++i) {
+    const int32_t *r = &range_[i * 4];
+    for (int32_t row = r[1]; row <= r[3]; ++row)
+      for (int32_t col = r[0]; col <= r[2]; ++col)
+        items_[cellStart_[row * cols_ + col]++] = (uint32_t)i;
+  }
+  // Shift the cursors back to the cell starts.
+  for (size_t c = cellStart_.size() - 1; c > 0; --c)
+    cellStart_[c] = cellStart_[c - 1];
+  cellStart_[0] = 0;
+}
+
+void SpatialGrid::query(float x, float y, float w, float h, std::vector<uint32_t> &out) const {
+  out.clear();
+  int32_t r[4];
+  cellRange(x, y, w, h, r);
+  for (int32_t row = r[1]; row <= r[3]; ++row) {
+    for (int32_t col = r[0]; col <= r[2]; ++col) {
+      int32_t c = row * cols_ + col;
+      out.insert(out.end(), items_.begin() + cellStart_[c], items_.begin() + cellStart_[c + 1]);
+    }
+  }
+  // Items spanning several cells were added more than once.
+  if (r[0] != r[2] || r[1] != r[3]) {
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+  }
+}
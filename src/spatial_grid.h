@@ -0,0 +1,36 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/// Broadphase for AABB collision tests: a uniform grid over a fixed playfield,
+/// rebuilt from scratch every tick. Each item is stored by index in every cell
+/// its box overlaps. Items outside the playfield are clamped into the edge
+/// cells, so queries never miss anything, they just get more candidates.
+///
+/// The cell lists are laid out with a counting sort, so once the buffers have
+/// grown to the working set, rebuilding doesn't allocate.
+class SpatialGrid {
+  float invCellSize_;
+  int cols_, rows_;
+  /// Index of the first entry of each cell in items_; cellStart_[cells] is
+  /// the total.
+  std::vector<uint32_t> cellStart_;
+  std::vector<uint32_t> items_;
+  /// Per item cell range, computed once in the counting pass.
+  std::vector<int32_t> range_;
+
+  void cellRange(float x, float y, float w, float h, int32_t *out) const;
+
+ public:
+  SpatialGrid(float width, float height, float cellSize);
+
+  /// Rebuild the grid from \p n boxes given as separate columns.
+  void build(const float *x, const float *y, const float *w, const float *h, size_t n);
+
+  /// Replace the contents of \p out with the indices of all items sharing a
+  /// cell with the box, in ascending order and without duplicates. Callers
+  /// still have to do the exact overlap test.
+  void query(float x, float y, float w, float h, std::vector<uint32_t> &out) const;
+};
@@ -0,0 +1,39 @@
+#include "sprite_batch.h"
+
+#include <algorithm>
+#include <cassert>
+
+void SpriteBatch::begin(ImDrawList *dl, ImTextureID tex, size_t count) {
+  assert(!dl_ && "SpriteBatch::begin() without end()");
+  dl_ = dl;
+  uv0_ = {0, 0};
+  uv1_ = {1, 1};
+  reserved_ = 0;
+  pending_ = count;
+  ImDrawList_PushTextureID(dl, tex);
+}
+
+void SpriteBatch::beginSolid(ImDrawList *dl, size_t count) {
+  // Solid rectangles are drawn like ImGui draws them: with the font atlas and
+  // the UV of its white pixel, so that they don't break the current run of
+  // widget draws.
+  begin(dl, igGetIO()->Fonts->TexID, count);
+  igGetFontTexUvWhitePixel(&uv0_);
+  uv1_ = uv0_;
+}
+
+void SpriteBatch::reserve() {
+  assert(pending_ && "SpriteBatch: more quads than announced to begin()");
+  size_t n = std::min(pending_, CHUNK_QUADS);
+  pending_ -= n;
+  reserved_ = n;
+  ImDrawList_PrimReserve(dl_, (int)n * 6, (int)n * 4);
+}
+
+void SpriteBatch::end() {
+  if (reserved_)
+    ImDrawList_PrimUnreserve(dl_, (int)reserved_ * 6, (int)reserved_ * 4);
+  ImDrawList_PopTextureID(dl_);
+  dl_ = nullptr;
+  reserved_ = pending_ = 0;
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#ifndef CIMGUI_DEFINE_ENUMS_AND_STRUCTS
+#define CIMGUI_DEFINE_ENUMS_AND_STRUCTS
+#endif
+#include "cimgui.h"
+
+#include <cstddef>
+
+/// Writes axis-aligned quads straight into the vertex and index buffers of an
+/// ImDrawList, instead of going through one ImDrawList_AddImage() or
+/// ImDrawList_AddRectFilled() call per quad.
+///
+/// Quads are drawn in runs that share one texture: begin() switches the
+/// texture and reserves room for the whole run with PrimReserve(), rect()
+/// writes the vertices without any checks, and end() releases what wasn't
+/// used. Each run becomes a single draw command (or a few, when it has to be
+/// split to keep 16-bit indices in range).
+///
+/// Positions passed to rect() are in game units and are mapped to screen
+/// pixels by the transform set with setTransform().
+class SpriteBatch {
+  /// Quads per PrimReserve(), so that a reservation never needs more than the
+  /// 64k vertices addressable by a 16-bit index.
+  static const size_t CHUNK_QUADS = 16384 - 1;
+
+  ImDrawList *dl_ = nullptr;
+  ImVec2 uv0_{0, 0}, uv1_{1, 1};
+  ImVec2 org_{0, 0}, scale_{1, 1};
+  /// Quads still reserved in the current chunk.
+  size_t reserved_ = 0;
+  /// Quads announced to begin() that are not reserved yet.
+  size_t pending_ = 0;
+
+  void reserve();
+
+ public:
+  /// Map game position (x, y) to screen position (org + x * scale).
+  void setTransform(ImVec2 org, ImVec2 scale) {
+    org_ = org;
+    scale_ = scale;
+  }
+
+  /// Start a run of at most \p count quads textured with the whole of \p tex.
+  void begin(ImDrawList *dl, ImTextureID tex, size_t count);
+  /// Start a run of at most \p count solid-colored quads.
+  void beginSolid(ImDrawList *dl, size_t count);
+  /// Finish the current run.
+  void end();
+
+  /// Add a quad with its top-left corner at (x, y), in game units.
+  void rect(float x, float y, float w, float h, ImU32 col) {
+    if (!reserved_)
+      reserve();
+    --reserved_;
+
+    float x0 = org_.x + x * scale_.x, y0 = org_.y + y * scale_.y;
+    float x1 = x0 + w * scale_.x, y1 = y0 + h * scale_.y;
+
+    ImDrawVert *v = dl_->_VtxWritePtr;
+    ImDrawIdx *idx = dl_->_IdxWritePtr;
+    ImDrawIdx base = (ImDrawIdx)dl_->_VtxCurrentIdx;
+    v[0] = ImDrawVert{{x0, y0}, uv0_, col};
+    v[1] = ImDrawVert{{x1, y0}, {uv1_.x, uv0_.y}, col};
+    v[2] = ImDrawVert{{x1, y1}, uv1_, col};
+    v[3] = ImDrawVert{{x0, y1}, {uv0_.x, uv1_.y}, col};
+    idx[0] = base;
+    idx[1] = (ImDrawIdx)(base + 1);
+    idx[2] = (ImDrawIdx)(base + 2);
+    idx[3] = base;
+    idx[4] = (ImDrawIdx)(base + 2);
+    idx[5] = (ImDrawIdx)(base + 3);
+    dl_->_VtxWritePtr = v + 4;
+    dl_->_IdxWritePtr = idx + 6;
+    dl_->_VtxCurrentIdx += 4;
+  }
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+/// Lock-free bounded queue with one producer thread and one consumer thread.
+///
+/// The producer only writes tail_ and the consumer only writes head_, each on
+/// its own cache line, and both only ever grow, so an index is a slot modulo
+/// N. \p N must be a power of two.
+template <typename T, size_t N>
+class SpscQueue {
+  static_assert(N && (N & (N - 1)) == 0, "capacity must be a power of two");
+
+ public:
+  /// Append \p value. Returns false, dropping it, if the queue is full.
+  bool push(const T &value) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (tail - head_.load(std::memory_order_acquire) == N)
+      return false;
+    slots_[tail % N] = value;
+    tail_.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  /// Remove the oldest value into \p out. Returns false if the queue is empty.
+  bool pop(T &out) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_.load(std::memory_order_acquire))
+      return false;
+    out = slots_[head % N];
+    head_.store(head + 1, std::memory_order_release);
+    return true;
+  }
+
+ private:
+  T slots_[N];
+  alignas(64) std::atomic<size_t> head_{0};
+  alignas(64) std::atomic<size_t> tail_{0};
+};
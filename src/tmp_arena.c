@@ -0,0 +1,78 @@
+#include "tmp_arena.h"
+
+#include <stdlib.h>
+
+/// Chunks form a list in the order they are used. The header is padded to
+/// TMP_ARENA_ALIGN, so the data that follows it is aligned as well.
+typedef struct Chunk {
+  struct Chunk *next;
+  size_t size;
+  _Alignas(TMP_ARENA_ALIGN) char data[];
+} Chunk;
+
+char *tmp_arena_cur = NULL;
+char *tmp_arena_end = NULL;
+
+static Chunk *s_first = NULL;
+static Chunk *s_current = NULL;
+/// Bytes used in the chunks before s_current since the last reset.
+static size_t s_usedBefore = 0;
+static size_t s_highWater = 0;
+static size_t s_capacity = 0;
+
+static size_t used_now(void) {
+  return s_current ? s_usedBefore + (size_t)(tmp_arena_cur - s_current->data) : 0;
+}
+
+void *tmp_arena_alloc_slow(size_t size) {
+  // Reuse the following chunks if they are big enough. Chunks that are too
+  // small for this request stay in the list and are used in later frames.
+  Chunk *prev = s_current;
+  Chunk *next = s_current ? s_current->next : s_first;
+  while (next && next->size < size) {
+    prev = next;
+    next = next->next;
+  }
+
+  if (!next) {
+    size_t chunkSize = size > TMP_ARENA_CHUNK_SIZE ? size : TMP_ARENA_CHUNK_SIZE;
+    // malloc() is 16-byte aligned on all the platforms we target.
+    next = (Chunk *)malloc(sizeof(Chunk) + chunkSize);
+    if (!next)
+      return NULL;
+    next->next = NULL;
+    next->size = chunkSize;
+    s_capacity += chunkSize;
+    if (prev)
+      prev->next = next;
+    else
+      s_first = next;
+  }
+
+  if (s_current)
+    s_usedBefore += (size_t)(tmp_arena_cur - s_current->data);
+  s_current = next;
+  tmp_arena_cur = next->data + size;
+  tmp_arena_end = next->data + next->size;
+  return next->data;
+}
+
+void tmp_arena_reset(void) {
+  size_t used = used_now();
+  if (used > s_highWater)
+    s_highWater = used;
+
+  s_usedBefore = 0;
+  s_current = s_first;
+  tmp_arena_cur = s_first ? s_first->data : NULL;
+  tmp_arena_end = s_first ? s_first->data + s_first->size : NULL;
+}
+
+size_t tmp_arena_high_water(void) {
+  size_t used = used_now();
+  return used > s_highWater ? used : s_highWater;
+}
+
+size_t tmp_arena_capacity(void) {
+  return s_capacity;
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <stddef.h>
+#include <string.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// A bump allocator for the temporary native memory of the JS code: the
+// ImVec2 arguments and ASCIIZ strings passed to ImGui during one frame.
+//
+// Allocations are 16-byte aligned and are not zeroed unless requested.
+// Memory comes from chunks of at least TMP_ARENA_CHUNK_SIZE bytes, which are
+// kept for the lifetime of the process: tmp_arena_reset() makes all of them
+// available again, so a steady-state frame doesn't call malloc() at all.
+
+enum { TMP_ARENA_ALIGN = 16, TMP_ARENA_CHUNK_SIZE = 64 * 1024 };
+
+/// The free space of the current chunk. Only tmp_arena.c modifies these.
+extern char *tmp_arena_cur;
+extern char *tmp_arena_end;
+
+/// Continue in the next chunk, allocating one if needed. Returns NULL if out
+/// of memory.
+void *tmp_arena_alloc_slow(size_t size);
+
+/// Allocate \p size bytes, valid until the next tmp_arena_reset(). Returns
+/// NULL if out of memory. A zero-byte request still gets a unique non-NULL
+/// pointer, so that NULL always means out of memory.
+static inline void *tmp_arena_alloc(size_t size) {
+  if (size == 0)
+    size = 1;
+  size = (size + (TMP_ARENA_ALIGN - 1)) & ~(size_t)(TMP_ARENA_ALIGN - 1);
+  if (size <= (size_t)(tmp_arena_end - tmp_arena_cur)) {
+    void *res = tmp_arena_cur;
+    tmp_arena_cur += size;
+    return res;
+  }
+  return tmp_arena_alloc_slow(size);
+}
+
+/// Like tmp_arena_alloc(), but the memory is zeroed.
+static inline void *tmp_arena_alloc_zero(size_t size) {
+  void *res = tmp_arena_alloc(size);
+  if (res)
+    memset(res, 0, size);
+  return res;
+}
+
+/// Release everything allocated since the last reset, keeping the chunks.
+void tmp_arena_reset(void);
+
+/// Most bytes (including alignment padding) allocated between two resets so
+/// far.
+size_t tmp_arena_high_water(void);
+/// Total size of the chunks.
+size_t tmp_arena_capacity(void);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <atomic>
+
+/// Lock-free single-producer, single-consumer handoff of the latest value.
+///
+/// Of the three slots, the writer owns one (back), the reader owns one (front)
+/// and the third is in the middle. publish() swaps the back slot with the
+/// middle one and marks it fresh; acquire() swaps the front slot with the
+/// middle one if it is fresh. Neither side ever waits for the other, and the
+/// reader always gets the most recently published value, skipping older ones.
+template <typename T>
+class TripleBuffer {
+ public:
+  /// The slot the writer fills. Only the writer may touch it.
+  T &back() {
+    return slots_[back_];
+  }
+  /// Make back() the latest value and continue with another slot, which holds
+  /// an older value.
+  void publish() {
+    back_ = middle_.exchange(back_ | FRESH, std::memory_order_acq_rel) & INDEX;
+  }
+
+  /// Take the latest published value into front(), if there is one that the
+  /// reader hasn't seen yet. Returns whether front() changed.
+  bool acquire() {
+    if (!(middle_.load(std::memory_order_relaxed) & FRESH))
+      return false;
+    front_ = middle_.exchange(front_, std::memory_order_acq_rel) & INDEX;
+    return true;
+  }
+  /// The slot the reader uses. Only the reader may touch it.
+  const T &front() const {
+    return slots_[front_];
+  }
+
+ private:
+  static constexpr unsigned INDEX = 3;
+  static constexpr unsigned FRESH = 4;
+
+  T slots_[3];
+  unsigned back_ = 0;
+  unsigned front_ = 1;
+  /// The index of the middle slot, with FRESH if it was published after the
+  /// reader last acquired. On its own cache line, since both threads write it.
+  alignas(64) std::atomic<unsigned> middle_{2};
+};
@@ -109,9 +109,73 @@ def need_cwrap(id):
     return id_to_element[id].tag == "Struct" or id_to_element[id].tag == "Union"
 
 
+# Structs with at most this many fields, all of fundamental type, are split
+# into scalar parameters in --split-structs mode.
+MAX_SPLIT_FIELDS = 4
+
+# Mapping from the ID of a struct to its Field elements, in declaration order.
+struct_fields = {}
+
+
+# The fields of a struct argument that is passed as separate scalars, or None
+# if the argument is passed by pointer.
+def split_fields(id):
+    if not split_structs:
+        return None
+    elem = id_to_element[id]
+    if elem.tag != "Struct":
+        return None
+    fields = struct_fields.get(elem.get("id"), [])
+    if not fields or len(fields) > MAX_SPLIT_FIELDS:
+        return None
+    for field in fields:
+        if field.get("bits") or id_to_element[field.get("type")].tag != "FundamentalType":
+            return None
+    return fields
+
+
+# The struct name, field name, SH type and byte offset of a Field element, and
+# whether it is accessed by address (structs, unions and arrays) rather than
+# read and written as a scalar. None for bitfields, which castxml marks with
+# bits= and which can't be read or written as a whole word without clobbering
+# their neighbours, and for anonymous unions and structs, which have no name.
+def field_info(field):
+    if field.get("bits") or not field.get("name"):
+        return None
+    field_type_id = field.get("type")
+    field_type_elem = id_to_element[field_type_id]
+    struct_name = id_to_element[field.get("context")].get("name")
+    offset = int(field.get("offset")) // 8
+    by_address = (
+        field_type_elem.tag == "Array"
+        or field_type_elem.tag == "Union"
+        or field_type_elem.tag == "Struct"
+    )
+    return struct_name, field.get("name"), to_sh_name(field_type_id), offset, by_address
+
+
+# --split-structs: pass small structs like ImVec2 and ImVec4 by value as
+# their scalar fields (x, y, ...), which the C wrapper reassembles on the
+# stack, instead of through a pointer to a temporary copy.
+split_structs = "--split-structs" in sys.argv
+if split_structs:
+    sys.argv.remove("--split-structs")
+
+# --views=A,B: emit field offset constants and view classes for structs A and
+# B. Only the structs that JS code actually addresses this way are listed, so
+# that the output doesn't grow by a class per struct.
+view_structs = set()
+for arg in sys.argv[1:]:
+    if arg.startswith("--views="):
+        view_structs = set(arg[len("--views=") :].split(","))
+        sys.argv.remove(arg)
+        break
+
 # Get the filename from the command line arguments
 if len(sys.argv) < 3:
-    print("Usage: ffigen.py <cwrap|js> <filename> [filter filenames]")
+    print(
+        "Usage: ffigen.py [--split-structs] [--views=A,B] <cwrap|js> <filename> [filter filenames]"
+    )
     print(
         "Last argument optionally provides an allow-list of files from which to export types and functions."
     )
@@ -164,6 +228,9 @@ for typedef in root.findall(".//Typedef"):
 for cv in root.findall(".//CvQualifiedType"):
     id_to_element[cv.get("id")] = id_to_element[cv.get("type")]
 
+for field in root.findall(".//Field"):
+    struct_fields.setdefault(field.get("context"), []).append(field)
+
 if mode == "js":
     # Generate JS declarations
     for func in root.findall(".//Function"):
@@ -193,11 +260,15 @@ if mode == "js":
 
             # Emit each parameter in the SH signature.
             arg_name = arg.get("name")
-            arg_type = to_sh_name(arg.get("type"))
-            if arg_name:
-                args.append(f"_{arg_name}: {arg_type}")
+            if not arg_name:
+                arg_name = str(len(args))
+            fields = split_fields(arg.get("type"))
+            if fields:
+                for field in fields:
+                    field_type = to_sh_name(field.get("type"))
+                    args.append(f"_{arg_name}_{field.get('name')}: {field_type}")
             else:
-                args.append(f"_{len(args)}: {arg_type}")
+                args.append(f"_{arg_name}: {to_sh_name(arg.get('type'))}")
 
         js_declaration = (
             "const _"
@@ -224,26 +295,31 @@ if mode == "js":
                 size = int(size) // 8
                 print(f"const _sizeof_{name} = {size};")
 
+    # Generate field offsets of the --views structs, for code that addresses
+    # them through typed array views or pointer arithmetic.
+    for type in ["Struct", "Union"]:
+        for elem in root.findall(".//" + type):
+            if elem.get("file") not in allowed_file_ids or elem.get("name") not in view_structs:
+                continue
+            for field in struct_fields.get(elem.get("id"), []):
+                info = field_info(field)
+                if not info:
+                    continue
+                struct_name, field_name, _, offset, _ = info
+                print(f"const _offsetof_{struct_name}_{field_name} = {offset};")
+
     # Generate struct accessors
     for field in root.findall(".//Field"):
         if field.get("file") not in allowed_file_ids:
             continue
-        field_name = field.get("name")
-        field_type_id = field.get("type")
-        field_type_elem = id_to_element[field_type_id]
-
-        struct_name = id_to_element[field.get("context")].get("name")
-        sh_type = to_sh_name(field_type_id)
-
-        offset = int(field.get("offset")) // 8
+        info = field_info(field)
+        if not info:
+            continue
+        struct_name, field_name, sh_type, offset, by_address = info
 
         # If the field is a struct, union, or array, return a pointer to
         # it and do not emit a setter.
-        if (
-            field_type_elem.tag == "Array"
-            or field_type_elem.tag == "Union"
-            or field_type_elem.tag == "Struct"
-        ):
+        if by_address:
             print(f"function get_{struct_name}_{field_name}(s: c_ptr): {sh_type} {{")
             print(f'  "inline";\n  return _sh_ptr_add(s, {offset});\n}}')
         else:
@@ -255,6 +331,33 @@ if mode == "js":
             )
             print(f'  "inline";\n  _sh_ptr_write_{sh_type}(s, {offset}, v);\n}}')
 
+    # Generate view classes of the --views structs: a base pointer with a getter
+    # and setter per field, reading and writing at constant offsets. Assigning
+    # ptr moves the view to another instance, e.g. the next element of an array.
+    for type in ["Struct", "Union"]:
+        for elem in root.findall(".//" + type):
+            if elem.get("file") not in allowed_file_ids or elem.get("name") not in view_structs:
+                continue
+            infos = [field_info(field) for field in struct_fields.get(elem.get("id"), [])]
+            infos = [info for info in infos if info]
+            if not infos:
+                continue
+            print(f"class {elem.get('name')}View {{")
+            print("  ptr: c_ptr;")
+            print("  constructor(ptr: c_ptr) {\n    this.ptr = ptr;\n  }")
+            for _, field_name, sh_type, offset, by_address in infos:
+                if by_address:
+                    print(f"  get_{field_name}(): {sh_type} {{")
+                    print(f'    "inline";\n    return _sh_ptr_add(this.ptr, {offset});\n  }}')
+                else:
+                    print(f"  get_{field_name}(): {sh_type} {{")
+                    print(
+                        f'    "inline";\n    return _sh_ptr_read_{sh_type}(this.ptr, {offset});\n  }}'
+                    )
+                    print(f"  set_{field_name}(v: {sh_type}): void {{")
+                    print(f'    "inline";\n    _sh_ptr_write_{sh_type}(this.ptr, {offset}, v);\n  }}')
+            print("}")
+
     # Generate JS constants from the ordered dictionary
     if len(constants_dict):
         print()
@@ -307,11 +410,20 @@ elif mode == "cwrap":
 
         # The arguments to the call to the wrapped function.
         args = []
-        for arg in func.findall(".//Argument"):
-            n = len(params)
-            # If the parameter type requires wrapping, accept it as a pointer
-            # and dereference it.
-            if need_cwrap(arg.get("type")):
+        for index, arg in enumerate(func.findall(".//Argument")):
+            n = index + (1 if need_cwrap(return_id) else 0)
+            fields = split_fields(arg.get("type"))
+            # If the parameter is split, accept its fields and rebuild it as a
+            # compound literal. Otherwise, if the parameter type requires
+            # wrapping, accept it as a pointer and dereference it.
+            if fields:
+                names = []
+                for field in fields:
+                    name = f"a{n}_{field.get('name')}"
+                    params.append(to_c_name(field.get("type")) + " " + name)
+                    names.append(name)
+                args.append(f"({to_c_name(arg.get('type'))}){{{', '.join(names)}}}")
+            elif need_cwrap(arg.get("type")):
                 params.append(to_c_name(arg.get("type")) + f"* a{n}")
                 args.append(f"*a{n}")
             else: